@@ -0,0 +1,401 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "binary_trace.h"
+#include "command_list.h"
+#include "memory_management.h"
+#include "parser.h"
+
+#define BENCH_REGION_SIZE (16 * 1024 * 1024)  // 16 MB: la carga generada no debería llenarlo
+#define BENCH_DEFAULT_OPS 200000
+#define BENCH_DEFAULT_SEED 1
+#define BENCH_LIVE_LIMIT  (BENCH_REGION_SIZE / 2)
+#define BENCH_NAME_LENGTH 16                  // "b" + hasta 14 dígitos + '\0'
+#define BENCH_TYPES       3                   // ALLOC, REALLOC y FREE (el resto no se mide)
+
+static const char* const BENCH_TYPE_NAMES[BENCH_TYPES] = {"ALLOC", "REALLOC", "FREE"};
+
+/**
+ * Comandos a repetir:
+ *  - list: los comandos (de un archivo, con sus nombres dentro del mapeo, o generados)
+ *  - names: con la carga generada, el texto de todos los nombres (list apunta dentro)
+ */
+typedef struct {
+  CommandList list;
+  char*       names;
+} BenchTrace;
+
+/**
+ * Resultado de una estrategia:
+ *  - latencies[t] / count[t]: nanosegundos de cada comando de tipo t, en orden de ejecución
+ *  - failed[t]: comandos de tipo t que devolvieron EXIT_FAILURE (la repetición sigue igual)
+ *  - seconds: tiempo total de la repetición
+ *  - node_allocs / node_frees: nodos Block pedidos y devueltos al pool (splits y merges)
+ *  - peak_nodes: máximo de nodos Block vivos a la vez (high_water del pool)
+ */
+typedef struct {
+  uint64_t* latencies[BENCH_TYPES];
+  size_t    count[BENCH_TYPES];
+  size_t    failed[BENCH_TYPES];
+  double    seconds;
+  size_t    searches;
+  size_t    search_steps;
+  size_t    metadata_bytes;
+  size_t    node_allocs;
+  size_t    node_frees;
+  size_t    peak_nodes;
+} BenchResult;
+
+/**************************************************************************************************
+ * bench_random
+ *
+ *  LCG de 32 bits; como en stress, la misma semilla da la misma carga en cualquier máquina.
+ */
+static unsigned bench_random(unsigned* seed) {
+  *seed = *seed * 1103515245u + 12345u;
+  return *seed >> 8;
+}
+
+/**************************************************************************************************
+ * bench_generate
+ *
+ *  Carga sintética de 'ops' comandos: ALLOC de tamaño log-uniforme en [16, 4096) mientras
+ *  los bytes vivos no pasen BENCH_LIVE_LIMIT, FREE de un bloque vivo al azar y REALLOC que solo
+ *  achican (un REALLOC que crece puede “fugar” o no según la estrategia, y la carga tiene que ser
+ *  la misma para todas).
+ */
+static int bench_generate(BenchTrace* trace, size_t ops, unsigned seed) {
+  CommandList* list = &trace->list;
+  memset(list, 0, sizeof(CommandList));
+  list->commands = malloc(ops * sizeof(Command));
+  trace->names   = malloc(ops * BENCH_NAME_LENGTH);
+  Command** live = malloc(ops * sizeof(Command*));  // el ALLOC (o último REALLOC) de cada vivo
+  if (list->commands == NULL || trace->names == NULL || live == NULL) {
+    fprintf(stderr, "bench_generate: No se pudo reservar una carga de %zu comandos.\n", ops);
+    free(live);
+    free(trace->names);
+    command_list_destroy(list);
+    return EXIT_FAILURE;
+  }
+
+  size_t live_count = 0;
+  size_t live_bytes = 0;
+  for (size_t i = 0; i < ops; i++) {
+    Command* command   = &list->commands[i];
+    unsigned roll      = bench_random(&seed) % 100;
+    command->thread_id = 0;
+
+    if (live_count == 0 || (roll < 55 && live_bytes < BENCH_LIVE_LIMIT)) {
+      size_t magnitude = (size_t) 16 << (bench_random(&seed) % 8);  // 16 .. 2048
+      char*  name      = trace->names + i * BENCH_NAME_LENGTH;
+      int    length    = snprintf(name, BENCH_NAME_LENGTH, "b%zu", i);
+
+      command->type        = CMD_ALLOC;
+      command->name.data   = name;
+      command->name.length = (size_t) length;
+      command->size        = magnitude + bench_random(&seed) % magnitude;
+      live[live_count++]   = command;
+      live_bytes += command->size;
+      continue;
+    }
+
+    size_t   victim = bench_random(&seed) % live_count;
+    Command* owner  = live[victim];
+    command->name   = owner->name;
+
+    if (roll < 65 && owner->size > 1) {
+      command->type = CMD_REALLOC;
+      command->size = 1 + bench_random(&seed) % (owner->size - 1);
+      live_bytes -= owner->size - command->size;
+      live[victim] = command;
+      continue;
+    }
+
+    command->type = CMD_FREE;
+    command->size = 0;
+    live_bytes -= owner->size;
+    live[victim] = live[--live_count];
+  }
+
+  list->count    = ops;
+  list->capacity = ops;
+  free(live);
+  return EXIT_SUCCESS;
+}
+
+/**************************************************************************************************
+ * bench_load
+ *
+ *  Una traza de texto o binaria (ver binary_trace.h), cargada entera antes de medir.
+ */
+static int bench_load(BenchTrace* trace, const char* filename) {
+  trace->names = NULL;
+  return binary_trace_probe(filename) ? binary_trace_load(&trace->list, filename)
+                                      : command_list_load(&trace->list, filename);
+}
+
+/**************************************************************************************************
+ * bench_elapsed_ns
+ */
+static uint64_t bench_elapsed_ns(const struct timespec* start, const struct timespec* end) {
+  return (uint64_t) (end->tv_sec - start->tv_sec) * UINT64_C(1000000000) +
+         (uint64_t) end->tv_nsec - (uint64_t) start->tv_nsec;
+}
+
+/**************************************************************************************************
+ * bench_compare
+ */
+static int bench_compare(const void* a, const void* b) {
+  uint64_t x = *(const uint64_t*) a;
+  uint64_t y = *(const uint64_t*) b;
+  return (x > y) - (x < y);
+}
+
+/**************************************************************************************************
+ * bench_percentile
+ *
+ *  Sobre latencias ya ordenadas: el menor valor que deja al menos 'permille' milésimas de las
+ *  muestras por debajo o igual (rango ceil(permille * count / 1000)).
+ */
+static uint64_t bench_percentile(const uint64_t* sorted, size_t count, size_t permille) {
+  if (count == 0) {
+    return 0;
+  }
+  size_t rank = (count * permille + 999) / 1000;
+  return sorted[rank == 0 ? 0 : rank - 1];
+}
+
+/**************************************************************************************************
+ * bench_run
+ *
+ *  Repite la traza entera sobre un MemoryManagement nuevo, midiendo cada comando por separado
+ *  con CLOCK_MONOTONIC. Los comandos que fallan se cuentan y la repetición sigue.
+ */
+static int bench_run(StrategyType strategy, const MMOptions* options, const CommandList* list,
+                     BenchResult* result) {
+  memset(result, 0, sizeof(BenchResult));
+  for (int t = 0; t < BENCH_TYPES; t++) {
+    result->latencies[t] = malloc((list->count > 0 ? list->count : 1) * sizeof(uint64_t));
+    if (result->latencies[t] == NULL) {
+      fprintf(stderr, "bench_run: No se pudo reservar %zu latencias.\n", list->count);
+      return EXIT_FAILURE;
+    }
+  }
+
+  MemoryManagement mm;
+  if (mm_init(&mm, strategy, BENCH_REGION_SIZE, options) != EXIT_SUCCESS) {
+    return EXIT_FAILURE;
+  }
+
+  struct timespec run_start, run_end;
+  clock_gettime(CLOCK_MONOTONIC, &run_start);
+  for (size_t i = 0; i < list->count; i++) {
+    const Command* command = &list->commands[i];
+    if (!command_has_name(command->type)) {
+      continue;  // PRINT, STATS y COMPACT no se miden
+    }
+
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    int status = mm_execute_command(&mm, command);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    int t = (int) command->type;
+    result->latencies[t][result->count[t]++] = bench_elapsed_ns(&start, &end);
+    if (status != EXIT_SUCCESS) {
+      result->failed[t]++;
+    }
+  }
+  clock_gettime(CLOCK_MONOTONIC, &run_end);
+
+  result->seconds        = (double) bench_elapsed_ns(&run_start, &run_end) / 1e9;
+  result->searches       = mm.searches;
+  result->search_steps   = mm.search_steps;
+  result->metadata_bytes = mm_metadata_bytes(&mm);  // solo crece: el valor final es el pico
+  result->node_allocs    = mm.pool.acquires;
+  result->node_frees     = mm.pool.releases;
+  result->peak_nodes     = mm.pool.high_water;
+  mm_destroy(&mm);
+
+  for (int t = 0; t < BENCH_TYPES; t++) {
+    qsort(result->latencies[t], result->count[t], sizeof(uint64_t), bench_compare);
+  }
+  return EXIT_SUCCESS;
+}
+
+/**************************************************************************************************
+ * bench_result_destroy
+ */
+static void bench_result_destroy(BenchResult* result) {
+  for (int t = 0; t < BENCH_TYPES; t++) {
+    free(result->latencies[t]);
+    result->latencies[t] = NULL;
+  }
+}
+
+/**************************************************************************************************
+ * bench_print_csv
+ *
+ *  Una fila por tipo de comando más una fila ALL con el total; las columnas de búsqueda y
+ *  metadata son de la estrategia y se repiten en sus filas.
+ */
+static void bench_print_csv(StrategyType strategy, const BenchResult* result) {
+  double average = result->searches > 0
+                       ? (double) result->search_steps / (double) result->searches
+                       : 0.0;
+  size_t total = 0, failed = 0;
+  for (int t = 0; t < BENCH_TYPES; t++) {
+    total  += result->count[t];
+    failed += result->failed[t];
+  }
+
+  printf("%s,ALL,%zu,%zu,%.0f,,,,%.3f,%zu,%zu,%zu,%zu\n", strategy_name(strategy), total, failed,
+         result->seconds > 0 ? (double) total / result->seconds : 0.0, average,
+         result->metadata_bytes, result->node_allocs, result->node_frees, result->peak_nodes);
+
+  for (int t = 0; t < BENCH_TYPES; t++) {
+    const uint64_t* sorted = result->latencies[t];
+    size_t          count  = result->count[t];
+    uint64_t        sum    = 0;
+    for (size_t i = 0; i < count; i++) {
+      sum += sorted[i];
+    }
+    printf("%s,%s,%zu,%zu,%.0f,%llu,%llu,%llu,%.3f,%zu,%zu,%zu,%zu\n", strategy_name(strategy),
+           BENCH_TYPE_NAMES[t], count, result->failed[t],
+           sum > 0 ? (double) count * 1e9 / (double) sum : 0.0,
+           (unsigned long long) bench_percentile(sorted, count, 500),
+           (unsigned long long) bench_percentile(sorted, count, 990),
+           (unsigned long long) bench_percentile(sorted, count, 999), average,
+           result->metadata_bytes, result->node_allocs, result->node_frees, result->peak_nodes);
+  }
+}
+
+/**************************************************************************************************
+ * bench_print_json
+ *
+ *  Un objeto por estrategia, con los mismos datos que el CSV; el llamador pone los corchetes.
+ */
+static void bench_print_json(StrategyType strategy, const BenchResult* result, bool first) {
+  size_t total = 0, failed = 0;
+  for (int t = 0; t < BENCH_TYPES; t++) {
+    total  += result->count[t];
+    failed += result->failed[t];
+  }
+
+  printf("%s  {\"strategy\": \"%s\", \"ops\": %zu, \"failed\": %zu, \"seconds\": %.6f, "
+         "\"ops_per_sec\": %.0f, \"searches\": %zu, \"avg_search_length\": %.3f, "
+         "\"peak_metadata_bytes\": %zu, \"node_allocs\": %zu, \"node_frees\": %zu, "
+         "\"peak_nodes\": %zu, \"commands\": {",
+         first ? "" : ",\n", strategy_name(strategy), total, failed, result->seconds,
+         result->seconds > 0 ? (double) total / result->seconds : 0.0, result->searches,
+         result->searches > 0 ? (double) result->search_steps / (double) result->searches : 0.0,
+         result->metadata_bytes, result->node_allocs, result->node_frees, result->peak_nodes);
+
+  for (int t = 0; t < BENCH_TYPES; t++) {
+    const uint64_t* sorted = result->latencies[t];
+    size_t          count  = result->count[t];
+    printf("%s\"%s\": {\"count\": %zu, \"failed\": %zu, \"p50_ns\": %llu, \"p99_ns\": %llu, "
+           "\"p999_ns\": %llu}",
+           t == 0 ? "" : ", ", BENCH_TYPE_NAMES[t], count, result->failed[t],
+           (unsigned long long) bench_percentile(sorted, count, 500),
+           (unsigned long long) bench_percentile(sorted, count, 990),
+           (unsigned long long) bench_percentile(sorted, count, 999));
+  }
+  printf("}}");
+}
+
+/**************************************************************************************************
+ * main
+ *
+ *  bench [archivo] [--ops=N] [--seed=N] [--format=csv|json] [--tags] [--hugepages]
+ *  [--cache[=N]] [--coalesce=eager|lazy[:N]]: repite el archivo (texto o binario) o, sin
+ *  archivo, una carga generada de N comandos contra cada estrategia (con --tags, las cuatro que
+ *  lo admiten) y reporta throughput, p50/p99/p999 por tipo de comando, largo medio de búsqueda,
+ *  pico de metadata y nodos Block pedidos, devueltos y vivos a la vez (pico) en el pool.
+ */
+int main(int argc, char** argv) {
+  const char* filename = NULL;
+  size_t      ops      = BENCH_DEFAULT_OPS;
+  unsigned    seed     = BENCH_DEFAULT_SEED;
+  bool        json     = false;
+  MMOptions   options  = {0};
+
+  for (int i = 1; i < argc; i++) {
+    if (strncmp(argv[i], "--ops=", 6) == 0) {
+      ops = strtoul(argv[i] + 6, NULL, 10);
+    } else if (strncmp(argv[i], "--seed=", 7) == 0) {
+      seed = (unsigned) strtoul(argv[i] + 7, NULL, 10);
+    } else if (strcmp(argv[i], "--format=json") == 0) {
+      json = true;
+    } else if (strcmp(argv[i], "--format=csv") == 0) {
+      json = false;
+    } else if (strcmp(argv[i], "--tags") == 0) {
+      options.tags = true;
+    } else if (strcmp(argv[i], "--hugepages") == 0) {
+      options.hugepages = true;
+    } else if (strncmp(argv[i], "--cache", 7) == 0 || strncmp(argv[i], "--coalesce=", 11) == 0) {
+      if (parse_option(argv[i], &options) != EXIT_SUCCESS) {
+        return EXIT_FAILURE;
+      }
+    } else if (argv[i][0] != '-' && filename == NULL) {
+      filename = argv[i];
+    } else {
+      ops = 0;
+      break;
+    }
+  }
+  if (ops == 0) {
+    fprintf(stderr, "Usage: %s [trace] [--ops=N] [--seed=N] [--format=csv|json] [--tags] "
+            "[--hugepages] [--cache[=N]] [--coalesce=eager|lazy[:N]].\n",
+            argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  BenchTrace trace;
+  int loaded = filename != NULL ? bench_load(&trace, filename) : bench_generate(&trace, ops, seed);
+  if (loaded != EXIT_SUCCESS) {
+    return EXIT_FAILURE;
+  }
+
+  if (json) {
+    printf("[\n");
+  } else {
+    printf("strategy,command,count,failed,ops_per_sec,p50_ns,p99_ns,p999_ns,avg_search_length,"
+           "peak_metadata_bytes,node_allocs,node_frees,peak_nodes\n");
+  }
+
+  int  status = EXIT_SUCCESS;
+  bool first  = true;
+  for (int s = 0; s < STRATEGY_COUNT; s++) {
+    StrategyType strategy = (StrategyType) s;
+    if (options.tags && (strategy == STRATEGY_BUDDY || strategy == STRATEGY_TLSF)) {
+      continue;
+    }
+
+    BenchResult result;
+    if (bench_run(strategy, &options, &trace.list, &result) != EXIT_SUCCESS) {
+      bench_result_destroy(&result);
+      status = EXIT_FAILURE;
+      break;
+    }
+    if (json) {
+      bench_print_json(strategy, &result, first);
+    } else {
+      bench_print_csv(strategy, &result);
+    }
+    fflush(stdout);
+    bench_result_destroy(&result);
+    first = false;
+  }
+
+  if (json) {
+    printf("\n]\n");
+  }
+
+  command_list_destroy(&trace.list);
+  free(trace.names);
+  return status;
+}
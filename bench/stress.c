@@ -0,0 +1,280 @@
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "arena.h"
+#include "parser.h"
+
+#define STRESS_REGION_SIZE (64 * 1024 * 1024)  // 64 MB, repartidos entre las arenas
+#define STRESS_DEFAULT_OPS 200000              // ALLOC por hilo
+#define STRESS_MAX_THREADS 8
+#define STRESS_DOUBLE_EVERY 64                 // cada tantos FREE se repite uno (doble FREE)
+
+/**
+ * Buzón de un ALLOC: el hilo que asigna publica el handle y el hilo vecino lo libera.
+ *  - state: 0 = todavía no publicado, 1 = asignado, 2 = el ALLOC falló (nada que liberar)
+ */
+typedef struct {
+  atomic_int  state;
+  ArenaHandle handle;
+} StressSlot;
+
+typedef struct {
+  ArenaSet*   set;
+  StressSlot* outbox;  // ALLOC de este hilo
+  StressSlot* inbox;   // ALLOC del hilo anterior, que libera este hilo
+  size_t      ops;
+  size_t      home;
+  unsigned    thread_id;
+  size_t      failed_allocs;
+  size_t      remote_frees;
+  size_t      frees;
+  size_t      injected;  // dobles FREE inyectados, que las arenas deben descartar todos
+  pthread_t   handle;
+} StressWorker;
+
+/**************************************************************************************************
+ * stress_free_slot
+ *
+ *  Libera el bloque de un buzón publicado (si el ALLOC salió bien), llevando la cuenta de los
+ *  FREE remotos. Cada STRESS_DOUBLE_EVERY FREE repite el FREE para que la arena lo descarte
+ *  como doble. Con un FREE remoto se toma el mutex de la arena dueña: nadie vacía su pila entre
+ *  los dos, así que el bloque no puede liberarse del todo y reusarse (el segundo FREE sería
+ *  entonces de otro bloque vivo). Un FREE local solo se repite con una sola arena, donde ningún
+ *  otro hilo asigna.
+ */
+static void stress_free_slot(StressWorker* worker, StressSlot* slot, int state) {
+  if (state != 1) {
+    return;
+  }
+  bool   remote = slot->handle.arena != worker->home;
+  bool   repeat = ++worker->frees % STRESS_DOUBLE_EVERY == 0 && (remote || worker->set->count == 1);
+  Arena* owner  = &worker->set->arenas[slot->handle.arena];
+  if (remote) {
+    worker->remote_frees++;
+  }
+
+  if (repeat && remote) {
+    pthread_mutex_lock(&owner->lock);
+  }
+  arena_free_handle(worker->set, worker->home, &slot->handle);
+  if (repeat) {
+    arena_free_handle(worker->set, worker->home, &slot->handle);
+    worker->injected++;
+  }
+  if (repeat && remote) {
+    pthread_mutex_unlock(&owner->lock);
+  }
+}
+
+/**************************************************************************************************
+ * stress_run
+ *
+ *  Alterna: un ALLOC propio (publicado con release) y, si ya está publicado, el FREE del
+ *  siguiente bloque del vecino. Al final espera y libera lo que le quede al vecino.
+ */
+static void* stress_run(void* arg) {
+  StressWorker* worker = arg;
+  unsigned      seed   = 0x9e3779b9u * (worker->thread_id + 1);
+  size_t        next   = 0;
+  char          name[32];
+
+  for (size_t i = 0; i < worker->ops; i++) {
+    seed = seed * 1103515245u + 12345u;
+    size_t size = 16 + (seed >> 16) % 240;
+    int      length = snprintf(name, sizeof(name), "s%u_%zu", worker->thread_id, i);
+    NameView view   = {name, (size_t) length};
+
+    StressSlot* slot = &worker->outbox[i];
+    int result = arena_alloc_handle(worker->set, worker->home, view, size, &slot->handle);
+    if (result != EXIT_SUCCESS) {
+      worker->failed_allocs++;
+    }
+    atomic_store_explicit(&slot->state, result == EXIT_SUCCESS ? 1 : 2, memory_order_release);
+
+    int state = atomic_load_explicit(&worker->inbox[next].state, memory_order_acquire);
+    if (state != 0) {
+      stress_free_slot(worker, &worker->inbox[next], state);
+      next++;
+    }
+  }
+
+  while (next < worker->ops) {
+    int state = atomic_load_explicit(&worker->inbox[next].state, memory_order_acquire);
+    if (state == 0) {
+      sched_yield();
+      continue;
+    }
+    stress_free_slot(worker, &worker->inbox[next], state);
+    next++;
+  }
+  return NULL;
+}
+
+/**************************************************************************************************
+ * stress_indexed_free
+ *
+ *  Bloques libres alcanzables desde las cabezas de los índices (free_lists, o tlsf con TLSF)
+ *  siguiendo next_free; un doble FREE mal detectado corta o cicla esas listas. Se corta en
+ *  'limit' vueltas por si hay un ciclo.
+ */
+static size_t stress_indexed_free(const MemoryManagement* mm, size_t limit) {
+  size_t count = 0;
+  if (mm->strategy == STRATEGY_TLSF) {
+    for (size_t fl = 0; fl < TLSF_FL_COUNT; fl++) {
+      for (size_t sl = 0; sl < TLSF_SL_COUNT; sl++) {
+        for (Block* b = mm->tlsf.heads[fl][sl]; b != NULL && count <= limit; b = b->next_free) {
+          count++;
+        }
+      }
+    }
+    return count;
+  }
+  for (size_t k = 0; k < FREE_LISTS_CLASSES; k++) {
+    for (Block* b = mm->free_lists.heads[k]; b != NULL && count <= limit; b = b->next_free) {
+      count++;
+    }
+  }
+  return count;
+}
+
+/**************************************************************************************************
+ * stress_leaked
+ *
+ *  Con todos los hilos terminados: aplica los FREE diferidos y cuenta los bloques que siguen
+ *  ocupados (perdidos), los nodos del pool que no están en ninguna lista y las arenas cuyos
+ *  libres no coinciden con los de sus índices. Suma en *doubles los FREE que las arenas
+ *  descartaron por dobles.
+ */
+static size_t stress_leaked(ArenaSet* set, size_t* doubles) {
+  size_t leaked = 0;
+  *doubles      = 0;
+  for (size_t a = 0; a < set->count; a++) {
+    Arena* arena = &set->arenas[a];
+    pthread_mutex_lock(&arena->lock);
+    arena_drain(set, a);
+
+    size_t nodes = 0, free_blocks = 0;
+    for (Block* block = arena->mm.start_block; block != NULL; block = block->next) {
+      if (!block->free) {
+        leaked++;
+      } else {
+        free_blocks++;
+      }
+      nodes++;
+    }
+    size_t indexed = stress_indexed_free(&arena->mm, nodes);
+    if (indexed != free_blocks || free_blocks != arena->mm.stats.free_blocks) {
+      fprintf(stderr, "stress: Arena %zu: %zu libres en la lista, %zu en los índices.\n", a,
+              free_blocks, indexed);
+      leaked++;
+    }
+    if (nodes != arena->mm.pool.live) {
+      fprintf(stderr, "stress: Arena %zu: %zu nodos en la lista y %zu vivos en el pool.\n", a,
+              nodes, arena->mm.pool.live);
+      leaked++;
+    }
+    if (atomic_load(&arena->remote_pushed) != atomic_load(&arena->remote_drained)) {
+      fprintf(stderr, "stress: Arena %zu: FREE diferidos sin aplicar.\n", a);
+      leaked++;
+    }
+    *doubles += atomic_load(&arena->double_frees);
+    pthread_mutex_unlock(&arena->lock);
+  }
+  return leaked;
+}
+
+/**************************************************************************************************
+ * stress_round
+ *
+ *  Una corrida con 'threads' hilos y una arena por hilo. Imprime una línea CSV y devuelve
+ *  EXIT_FAILURE si se perdió algún bloque, si los índices de alguna arena no coinciden con su
+ *  lista o si las arenas no descartaron exactamente los dobles FREE inyectados.
+ */
+static int stress_round(StrategyType strategy, unsigned threads, size_t ops) {
+  ArenaSet set;
+  if (arena_set_init(&set, strategy, STRESS_REGION_SIZE, threads, NULL) != EXIT_SUCCESS) {
+    return EXIT_FAILURE;
+  }
+
+  StressWorker workers[STRESS_MAX_THREADS] = {0};
+  StressSlot*  slots[STRESS_MAX_THREADS]   = {0};
+  for (unsigned t = 0; t < threads; t++) {
+    slots[t] = calloc(ops, sizeof(StressSlot));
+    if (slots[t] == NULL) {
+      fprintf(stderr, "stress: No se pudo reservar %zu buzones.\n", ops);
+      for (unsigned u = 0; u < t; u++) {
+        free(slots[u]);
+      }
+      arena_set_destroy(&set);
+      return EXIT_FAILURE;
+    }
+  }
+
+  struct timespec start, end;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for (unsigned t = 0; t < threads; t++) {
+    workers[t].set       = &set;
+    workers[t].outbox    = slots[t];
+    workers[t].inbox     = slots[(t + threads - 1) % threads];
+    workers[t].ops       = ops;
+    workers[t].home      = arena_set_assign(&set);
+    workers[t].thread_id = t;
+    pthread_create(&workers[t].handle, NULL, stress_run, &workers[t]);
+  }
+
+  size_t failed = 0, remote = 0, injected = 0;
+  for (unsigned t = 0; t < threads; t++) {
+    pthread_join(workers[t].handle, NULL);
+    failed   += workers[t].failed_allocs;
+    remote   += workers[t].remote_frees;
+    injected += workers[t].injected;
+  }
+  clock_gettime(CLOCK_MONOTONIC, &end);
+
+  double seconds = (double) (end.tv_sec - start.tv_sec) +
+                   (double) (end.tv_nsec - start.tv_nsec) / 1e9;
+  size_t total   = 2 * ops * threads;  // un ALLOC y un FREE por bloque
+  size_t doubles = 0;
+  size_t leaked  = stress_leaked(&set, &doubles);
+
+  printf("%u,%zu,%zu,%.3f,%.2f,%zu,%zu,%zu,%zu,%zu\n", threads, set.count, total, seconds,
+         (double) total / seconds / 1e6, remote, failed, leaked, injected, doubles);
+  fflush(stdout);
+
+  for (unsigned t = 0; t < threads; t++) {
+    free(slots[t]);
+  }
+  arena_set_destroy(&set);
+  return leaked == 0 && doubles == injected ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/**************************************************************************************************
+ * main
+ *
+ *  stress [ops_por_hilo] [estrategia]: corre con 1, 2, 4 y 8 hilos (una arena por hilo), cada
+ *  hilo libera los bloques del anterior, así casi todos los FREE son remotos.
+ */
+int main(int argc, char** argv) {
+  size_t       ops      = argc > 1 ? strtoul(argv[1], NULL, 10) : STRESS_DEFAULT_OPS;
+  StrategyType strategy = STRATEGY_FIRST;
+  if (argc > 2 && parse_strategy(argv[2], &strategy) != EXIT_SUCCESS) {
+    return EXIT_FAILURE;
+  }
+  if (ops == 0) {
+    fprintf(stderr, "Usage: %s [ops_per_thread] [strategy].\n", argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  printf("threads,arenas,ops,seconds,mops_per_sec,remote_frees,failed_allocs,leaked,"
+         "injected_doubles,double_frees\n");
+  int result = EXIT_SUCCESS;
+  for (unsigned threads = 1; threads <= STRESS_MAX_THREADS; threads *= 2) {
+    if (stress_round(strategy, threads, ops) != EXIT_SUCCESS) {
+      result = EXIT_FAILURE;
+    }
+  }
+  return result;
+}
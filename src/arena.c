@@ -0,0 +1,492 @@
+#include "arena.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "compact.h"
+#include "purge.h"
+#include "region.h"
+
+/**
+ * Trabajo de un hilo de arena_replay: sus comandos son list->commands[order[begin..end)].
+ */
+typedef struct {
+  ArenaSet*          set;
+  const CommandList* list;
+  const size_t*      order;
+  size_t             begin;
+  size_t             end;
+  size_t             home;
+  unsigned           thread_id;
+  int                result;
+  pthread_t          handle;
+} ArenaWorker;
+
+/**************************************************************************************************
+ * arena_set_init
+ */
+int arena_set_init(ArenaSet* set, StrategyType strategy, size_t size, size_t count,
+                   const MMOptions* options) {
+  if (count == 0 || size / count < ARENA_ALIGN) {
+    fprintf(stderr, "arena_set_init: No se puede repartir %zu bytes en %zu arenas.\n", size, count);
+    return EXIT_FAILURE;
+  }
+  if (options != NULL && options->grow) {
+    fprintf(stderr, "arena_set_init: --grow no está disponible con --arenas.\n");
+    return EXIT_FAILURE;
+  }
+  if (options != NULL && options->pipeline) {
+    fprintf(stderr, "arena_set_init: --pipeline no está disponible con --arenas.\n");
+    return EXIT_FAILURE;
+  }
+
+  set->hugepages  = options != NULL && options->hugepages;
+  set->region     = region_map(size, set->hugepages);
+  set->arenas     = calloc(count, sizeof(Arena));
+  set->total_size = size;
+  set->count      = 0;
+  atomic_init(&set->next_arena, 0);
+  if (set->region == NULL || set->arenas == NULL) {
+    fprintf(stderr, "arena_set_init: No se pudo reservar la región de %zu bytes.\n", size);
+    arena_set_destroy(set);
+    return EXIT_FAILURE;
+  }
+
+  size_t slice = (size / count) & ~(size_t) (ARENA_ALIGN - 1);
+  for (size_t i = 0; i < count; i++) {
+    size_t base   = i * slice;
+    size_t length = i + 1 == count ? size - base : slice;  // la última se queda con el resto
+
+    Arena* arena = &set->arenas[i];
+    if (mm_init_region(&arena->mm, strategy, (char*) set->region + base, length, base, options) !=
+        EXIT_SUCCESS) {
+      arena_set_destroy(set);
+      return EXIT_FAILURE;
+    }
+    pthread_mutex_init(&arena->lock, NULL);
+    atomic_init(&arena->remote_frees, NULL);
+    atomic_init(&arena->remote_pushed, 0);
+    atomic_init(&arena->remote_drained, 0);
+    atomic_init(&arena->double_frees, 0);
+    set->count++;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+/**************************************************************************************************
+ * arena_set_destroy
+ */
+void arena_set_destroy(ArenaSet* set) {
+  for (size_t i = 0; i < set->count; i++) {
+    mm_destroy(&set->arenas[i].mm);
+    pthread_mutex_destroy(&set->arenas[i].lock);
+  }
+  free(set->arenas);
+  region_unmap(set->region, set->total_size, set->hugepages);
+  set->arenas = NULL;
+  set->region = NULL;
+  set->count  = 0;
+}
+
+/**************************************************************************************************
+ * arena_set_assign
+ */
+size_t arena_set_assign(ArenaSet* set) {
+  return atomic_fetch_add(&set->next_arena, 1) % set->count;
+}
+
+/**************************************************************************************************
+ * arena_drain
+ *
+ *  Con un solo consumidor alcanza con atomic_exchange para llevarse la pila entera: no hay ABA.
+ *  El acquire empareja con el release de arena_free_handle, así los next_free se leen completos.
+ */
+size_t arena_drain(ArenaSet* set, size_t index) {
+  Arena* arena = &set->arenas[index];
+  Block* block = atomic_exchange_explicit(&arena->remote_frees, NULL, memory_order_acquire);
+
+  size_t drained = 0;
+  while (block != NULL) {
+    Block* next = block->next_free;
+    block->next_free = NULL;
+    mm_free_block(&arena->mm, block);  // BLOCK_PENDING: nadie más lo tocó desde el push
+    block = next;
+    drained++;
+  }
+
+  if (drained > 0) {
+    atomic_fetch_add_explicit(&arena->remote_drained, drained, memory_order_relaxed);
+  }
+  return drained;
+}
+
+/**************************************************************************************************
+ * arena_try_alloc
+ *
+ *  Con el mutex de la arena: aplica los FREE diferidos y asigna con mm_try_alloc. Guarda en
+ *  'handle' (si no es NULL) el bloque entregado y en *no_room si falló solo por falta de lugar.
+ */
+static int arena_try_alloc(ArenaSet* set, size_t index, NameView name, size_t size,
+                           ArenaHandle* handle, bool* no_room) {
+  Arena* arena = &set->arenas[index];
+
+  pthread_mutex_lock(&arena->lock);
+  arena_drain(set, index);
+  int result = mm_try_alloc(&arena->mm, name, size, no_room);
+  if (result == EXIT_SUCCESS && handle != NULL) {
+    handle->arena = index;
+    handle->block = arena->mm.last_alloc;
+  }
+  pthread_mutex_unlock(&arena->lock);
+
+  return result;
+}
+
+/**************************************************************************************************
+ * arena_alloc_other
+ *
+ *  Recorre las arenas desde home + 1 (sin volver a home) y asigna en la primera con lugar. Corta
+ *  en el primer error que no sea de falta de lugar (ya impreso).
+ */
+static int arena_alloc_other(ArenaSet* set, size_t home, NameView name, size_t size,
+                             ArenaHandle* handle, bool* no_room) {
+  for (size_t i = 1; i < set->count; i++) {
+    if (arena_try_alloc(set, (home + i) % set->count, name, size, handle, no_room) ==
+        EXIT_SUCCESS) {
+      return EXIT_SUCCESS;
+    }
+    if (!*no_room) {
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_FAILURE;
+}
+
+/**************************************************************************************************
+ * arena_alloc
+ */
+int arena_alloc(ArenaSet* set, size_t home, NameView name, size_t size) {
+  return arena_alloc_handle(set, home, name, size, NULL);
+}
+
+/**************************************************************************************************
+ * arena_alloc_handle
+ *
+ *  mm_try_alloc evita que una arena llena imprima un error cuando otra todavía tiene lugar, con
+ *  una sola búsqueda por arena; si ninguna tiene, el error sale una sola vez al final.
+ */
+int arena_alloc_handle(ArenaSet* set, size_t home, NameView name, size_t size,
+                       ArenaHandle* handle) {
+  if (handle != NULL && set->arenas[home].mm.options.tags) {
+    fprintf(stderr, "arena_alloc_handle: No disponible con --tags.\n");
+    return EXIT_FAILURE;
+  }
+
+  bool no_room;
+  if (arena_try_alloc(set, home, name, size, handle, &no_room) == EXIT_SUCCESS) {
+    return EXIT_SUCCESS;
+  }
+  if (!no_room) {
+    return EXIT_FAILURE;
+  }
+  if (arena_alloc_other(set, home, name, size, handle, &no_room) == EXIT_SUCCESS) {
+    return EXIT_SUCCESS;
+  }
+  if (no_room) {
+    fprintf(stderr,
+            "arena_alloc: No se encontró bloque suficiente en ninguna arena (se solicitó %zu "
+            "bytes) para %.*s.\n",
+            size, (int) name.length, name.data);
+  }
+  return EXIT_FAILURE;
+}
+
+/**************************************************************************************************
+ * arena_free_handle
+ *
+ *  Antes de tocar un enlace, el FREE se adueña del bloque con un CAS desde BLOCK_LIVE (a
+ *  BLOCK_RELEASED si es local, a BLOCK_PENDING si es remoto). Si el CAS falla el bloque ya está
+ *  libre, en la caché o encolado, y sus next_free pueden ser enlaces de una lista de libres:
+ *  no se escriben. El push es un CAS en bucle sobre la cabeza de la pila (Treiber). Como solo el
+ *  dueño saca bloques y siempre la pila entera, un bloque empujado no puede reaparecer en la
+ *  cabeza.
+ */
+void arena_free_handle(ArenaSet* set, size_t home, const ArenaHandle* handle) {
+  Arena* arena = &set->arenas[handle->arena];
+  bool   local = handle->arena == home;
+  int    live  = BLOCK_LIVE;
+  if (!atomic_compare_exchange_strong_explicit(&handle->block->state, &live,
+                                               local ? BLOCK_RELEASED : BLOCK_PENDING,
+                                               memory_order_acquire, memory_order_relaxed)) {
+    atomic_fetch_add_explicit(&arena->double_frees, 1, memory_order_relaxed);
+    return;
+  }
+
+  if (local) {
+    pthread_mutex_lock(&arena->lock);
+    mm_free_block(&arena->mm, handle->block);
+    pthread_mutex_unlock(&arena->lock);
+    return;
+  }
+
+  Block* head = atomic_load_explicit(&arena->remote_frees, memory_order_relaxed);
+  do {
+    handle->block->next_free = head;
+  } while (!atomic_compare_exchange_weak_explicit(&arena->remote_frees, &head, handle->block,
+                                                  memory_order_release, memory_order_relaxed));
+  atomic_fetch_add_explicit(&arena->remote_pushed, 1, memory_order_relaxed);
+}
+
+/**************************************************************************************************
+ * arena_realloc
+ */
+int arena_realloc(ArenaSet* set, size_t home, NameView name, size_t size) {
+  for (size_t i = 0; i < set->count; i++) {
+    size_t index = (home + i) % set->count;
+    Arena* arena = &set->arenas[index];
+
+    pthread_mutex_lock(&arena->lock);
+    arena_drain(set, index);  // un bloque con FREE diferido ya no debe encontrarse por nombre
+    if (!mm_contains(&arena->mm, name)) {
+      pthread_mutex_unlock(&arena->lock);
+      continue;
+    }
+    int result = mm_realloc(&arena->mm, name, size);
+    pthread_mutex_unlock(&arena->lock);
+
+    // mm_realloc solo falla si la “fuga” no entró en esta arena: se intenta en las demás.
+    if (result != EXIT_SUCCESS) {
+      bool no_room;
+      result = arena_alloc_other(set, index, name, size, NULL, &no_room);
+    }
+    return result;
+  }
+
+  fprintf(stderr, "arena_realloc: No se encontró bloque con nombre %.*s.\n", (int) name.length,
+          name.data);
+  return EXIT_FAILURE;
+}
+
+/**************************************************************************************************
+ * arena_free
+ */
+int arena_free(ArenaSet* set, size_t home, NameView name) {
+  for (size_t i = 0; i < set->count; i++) {
+    size_t index = (home + i) % set->count;
+    Arena* arena = &set->arenas[index];
+
+    pthread_mutex_lock(&arena->lock);
+    arena_drain(set, index);  // un bloque con FREE diferido ya no debe encontrarse por nombre
+    if (!mm_contains(&arena->mm, name)) {
+      pthread_mutex_unlock(&arena->lock);
+      continue;
+    }
+    int result = mm_free(&arena->mm, name);
+    pthread_mutex_unlock(&arena->lock);
+    return result;
+  }
+
+  fprintf(stderr, "arena_free: No se encontró bloque con nombre %.*s.\n", (int) name.length,
+          name.data);
+  return EXIT_FAILURE;
+}
+
+/**************************************************************************************************
+ * arena_print_each
+ *
+ *  Toma todos los mutex, aplica los FREE diferidos e imprime cada arena con 'print'.
+ */
+static void arena_print_each(ArenaSet* set, void (*print)(const MemoryManagement* mm)) {
+  for (size_t i = 0; i < set->count; i++) {
+    pthread_mutex_lock(&set->arenas[i].lock);
+  }
+
+  for (size_t i = 0; i < set->count; i++) {
+    arena_drain(set, i);
+    printf("Arena %zu:\n", i);
+    print(&set->arenas[i].mm);
+  }
+  fflush(stdout);
+
+  for (size_t i = set->count; i > 0; i--) {
+    pthread_mutex_unlock(&set->arenas[i - 1].lock);
+  }
+}
+
+/**************************************************************************************************
+ * arena_print / arena_print_stats
+ */
+void arena_print(ArenaSet* set) {
+  arena_print_each(set, mm_print);
+}
+
+void arena_print_stats(ArenaSet* set) {
+  arena_print_each(set, mm_stats_print);
+}
+
+/**************************************************************************************************
+ * arena_compact
+ */
+int arena_compact(ArenaSet* set, size_t budget) {
+  int result = EXIT_SUCCESS;
+  for (size_t i = 0; i < set->count && result == EXIT_SUCCESS; i++) {
+    pthread_mutex_lock(&set->arenas[i].lock);
+    arena_drain(set, i);
+    printf("Arena %zu:\n", i);
+    result = mm_compact_print(&set->arenas[i].mm, budget);
+    pthread_mutex_unlock(&set->arenas[i].lock);
+  }
+  fflush(stdout);
+  return result;
+}
+
+/**************************************************************************************************
+ * arena_purge
+ */
+int arena_purge(ArenaSet* set) {
+  size_t before = purge_rss();
+  size_t total  = 0;
+  int    result = EXIT_SUCCESS;
+  for (size_t i = 0; i < set->count && result == EXIT_SUCCESS; i++) {
+    size_t released;
+    pthread_mutex_lock(&set->arenas[i].lock);
+    arena_drain(set, i);
+    result = mm_purge(&set->arenas[i].mm, &released);
+    pthread_mutex_unlock(&set->arenas[i].lock);
+    total += released;
+  }
+  if (result == EXIT_SUCCESS) {
+    printf("Purge: %zu bytes released, RSS %zu KB -> %zu KB\n", total, before / 1024,
+           purge_rss() / 1024);
+    fflush(stdout);
+  }
+  return result;
+}
+
+/**************************************************************************************************
+ * arena_execute_command
+ */
+int arena_execute_command(ArenaSet* set, size_t home, const Command* command) {
+  switch (command->type) {
+    case CMD_ALLOC:
+      return arena_alloc(set, home, command->name, command->size);
+    case CMD_REALLOC:
+      return arena_realloc(set, home, command->name, command->size);
+    case CMD_FREE:
+      return arena_free(set, home, command->name);
+    case CMD_PRINT:
+      arena_print(set);
+      return EXIT_SUCCESS;
+    case CMD_STATS:
+      arena_print_stats(set);
+      return EXIT_SUCCESS;
+    case CMD_COMPACT:
+      return arena_compact(set, command->size);
+    case CMD_PURGE:
+      return arena_purge(set);
+    default:
+      fprintf(stderr,
+              "arena_execute_command: Tipo de comando desconocido: %d.\n",
+              command->type);
+      return EXIT_FAILURE;
+  }
+}
+
+/**************************************************************************************************
+ * arena_worker_run
+ */
+static void* arena_worker_run(void* arg) {
+  ArenaWorker* worker = arg;
+
+  worker->result = EXIT_SUCCESS;
+  for (size_t i = worker->begin; i < worker->end; i++) {
+    const Command* command = &worker->list->commands[worker->order[i]];
+    if (arena_execute_command(worker->set, worker->home, command) != EXIT_SUCCESS) {
+      fprintf(stderr, "arena_replay: Hilo T%u: Error al ejecutar el comando %zu.\n",
+              worker->thread_id, worker->order[i] + 1);
+      worker->result = EXIT_FAILURE;
+      break;
+    }
+  }
+  return NULL;
+}
+
+/**************************************************************************************************
+ * arena_replay
+ *
+ *  Agrupa los índices de comandos por thread_id (counting sort, estable) para que cada hilo
+ *  recorra solo los suyos. Las arenas se asignan en orden de thread_id, así la asignación no
+ *  depende de qué hilo arranca primero.
+ */
+int arena_replay(ArenaSet* set, const CommandList* list) {
+  size_t threads = 0;  // en size_t: thread_id + 1 no puede dar la vuelta
+  for (size_t i = 0; i < list->count; i++) {
+    if ((size_t) list->commands[i].thread_id + 1 > threads) {
+      threads = (size_t) list->commands[i].thread_id + 1;
+    }
+  }
+  if (threads == 0) {
+    return EXIT_SUCCESS;
+  }
+
+  size_t*      starts  = calloc(threads + 1, sizeof(size_t));
+  size_t*      order   = malloc((list->count + 1) * sizeof(size_t));
+  ArenaWorker* workers = calloc(threads, sizeof(ArenaWorker));
+  if (starts == NULL || order == NULL || workers == NULL) {
+    fprintf(stderr, "arena_replay: No se pudo reservar memoria para %zu hilos.\n", threads);
+    free(starts);
+    free(order);
+    free(workers);
+    return EXIT_FAILURE;
+  }
+
+  for (size_t i = 0; i < list->count; i++) {
+    starts[list->commands[i].thread_id + 1]++;
+  }
+  for (size_t t = 0; t < threads; t++) {
+    starts[t + 1] += starts[t];
+  }
+  for (size_t t = 0; t < threads; t++) {
+    workers[t].begin = starts[t];
+    workers[t].end   = starts[t];
+  }
+  for (size_t i = 0; i < list->count; i++) {
+    order[workers[list->commands[i].thread_id].end++] = i;
+  }
+
+  int result = EXIT_SUCCESS;
+  for (size_t t = 0; t < threads; t++) {
+    ArenaWorker* worker = &workers[t];
+    worker->set       = set;
+    worker->list      = list;
+    worker->order     = order;
+    worker->thread_id = (unsigned) t;
+    worker->result    = EXIT_SUCCESS;
+    if (worker->begin == worker->end) {
+      continue;
+    }
+
+    worker->home = arena_set_assign(set);
+    if (pthread_create(&worker->handle, NULL, arena_worker_run, worker) != 0) {
+      fprintf(stderr, "arena_replay: No se pudo crear el hilo T%zu.\n", t);
+      worker->end = worker->begin;  // no hay nada que esperar
+      result      = EXIT_FAILURE;
+    }
+  }
+
+  for (size_t t = 0; t < threads; t++) {
+    if (workers[t].begin == workers[t].end) {
+      continue;
+    }
+    pthread_join(workers[t].handle, NULL);
+    if (workers[t].result != EXIT_SUCCESS) {
+      result = EXIT_FAILURE;
+    }
+  }
+
+  free(starts);
+  free(order);
+  free(workers);
+  return result;
+}
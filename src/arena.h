@@ -0,0 +1,160 @@
+// arena.h
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "command.h"
+#include "command_list.h"
+#include "memory_management.h"
+
+/**
+ * Una arena: un MemoryManagement completo (lista, índices, nombres y pool propios) sobre un
+ * tramo de la región compartida, protegido por su propio mutex. Dos hilos con arenas distintas
+ * no comparten ningún dato mutable.
+ *  - remote_frees: pila lock-free (Treiber, varios productores y un consumidor) de bloques que
+ *    otros hilos liberaron sin tomar el mutex; se enlazan por next_free, que un bloque ocupado
+ *    no usa. Quien tiene el mutex la vacía entera con un solo exchange antes de asignar.
+ *  - remote_pushed / remote_drained: contadores de FREE diferidos encolados y ya aplicados.
+ *  - double_frees: FREE por handle descartados porque el bloque ya no estaba vivo (libre, en la
+ *    caché de --cache o con un FREE diferido pendiente; ver BlockState).
+ */
+typedef struct {
+  MemoryManagement mm;
+  pthread_mutex_t  lock;
+  _Atomic(Block*)  remote_frees;
+  atomic_size_t    remote_pushed;
+  atomic_size_t    remote_drained;
+  atomic_size_t    double_frees;
+} Arena;
+
+/**
+ * Referencia a un bloque asignado por arena_alloc_handle: la arena dueña y su nodo. Alcanza
+ * para liberarlo desde cualquier hilo sin buscar el nombre.
+ */
+typedef struct {
+  size_t arena;
+  Block* block;
+} ArenaHandle;
+
+/**
+ * Conjunto de arenas sobre una sola región:
+ *  - region / total_size / hugepages: la región compartida (un único region_map) y si se mapeó
+ *    con páginas grandes
+ *  - arenas / count: la arena i maneja [i * total_size / count, (i + 1) * total_size / count),
+ *    con los bordes alineados a ARENA_ALIGN
+ *  - next_arena: contador round-robin para asignar la arena propia de cada hilo
+ */
+typedef struct {
+  void*         region;
+  size_t        total_size;
+  bool          hugepages;
+  Arena*        arenas;
+  size_t        count;
+  atomic_size_t next_arena;
+} ArenaSet;
+
+#define ARENA_ALIGN 16
+
+/**
+ * arena_set_init / arena_set_destroy:
+ *  - Reserva la región y arma 'count' arenas con la misma estrategia y opciones.
+ *  - arena_set_init devuelve EXIT_FAILURE (sin dejar nada reservado) si falla alguna, o con
+ *    --grow o --pipeline, que no funcionan con arenas.
+ */
+int arena_set_init(ArenaSet* set, StrategyType strategy, size_t size, size_t count,
+                   const MMOptions* options);
+void arena_set_destroy(ArenaSet* set);
+
+/**
+ * arena_set_assign:
+ *  - Devuelve la arena propia para un hilo nuevo (round-robin).
+ */
+size_t arena_set_assign(ArenaSet* set);
+
+/**
+ * arena_alloc / arena_realloc / arena_free:
+ *  - Misma semántica que mm_alloc / mm_realloc / mm_free, empezando por la arena 'home':
+ *    - ALLOC usa la primera arena, desde home, que tenga lugar (una sola búsqueda por arena, con
+ *      mm_try_alloc); si ninguna tiene, falla con un solo error.
+ *    - FREE y REALLOC buscan el nombre desde home; si la “fuga” de REALLOC no entra en la arena
+ *      del bloque, el bloque nuevo se pide en otra.
+ *  - Cada operación toma un solo mutex a la vez.
+ */
+int arena_alloc(ArenaSet* set, size_t home, NameView name, size_t size);
+int arena_realloc(ArenaSet* set, size_t home, NameView name, size_t size);
+int arena_free(ArenaSet* set, size_t home, NameView name);
+
+/**
+ * arena_alloc_handle:
+ *  - Como arena_alloc, pero además devuelve en 'handle' dónde quedó el bloque. No disponible
+ *    con --tags (no hay nodos Block).
+ */
+int arena_alloc_handle(ArenaSet* set, size_t home, NameView name, size_t size,
+                       ArenaHandle* handle);
+
+/**
+ * arena_free_handle:
+ *  - Si el bloque es de la arena 'home', lo libera en el momento (con su mutex).
+ *  - Si es de otra arena, lo empuja a su remote_frees sin tomar ningún mutex (lock-free, O(1));
+ *    el join lo hace el dueño al vaciar la pila en su próximo ALLOC (o en PRINT).
+ *  - Un doble FREE (bloque libre, en la caché o ya encolado en remote_frees) no se aplica ni
+ *    toca ningún enlace: se cuenta en double_frees de la arena dueña. Si el nodo ya se reusó
+ *    para otro bloque vivo no se detecta.
+ */
+void arena_free_handle(ArenaSet* set, size_t home, const ArenaHandle* handle);
+
+/**
+ * arena_drain:
+ *  - Aplica todos los FREE diferidos de la arena 'index'. Requiere tener su mutex.
+ *  - Devuelve cuántos bloques liberó.
+ */
+size_t arena_drain(ArenaSet* set, size_t index);
+
+/**
+ * arena_print:
+ *  - Toma todos los mutex (en orden, para no bloquearse con nadie), aplica los FREE diferidos e
+ *    imprime cada arena con mm_print, con offsets relativos a la región compartida.
+ */
+void arena_print(ArenaSet* set);
+
+/**
+ * arena_print_stats:
+ *  - Como arena_print, pero con mm_stats_print (comando STATS) en lugar de la lista de bloques.
+ */
+void arena_print_stats(ArenaSet* set);
+
+/**
+ * arena_compact:
+ *  - Comando COMPACT [K]: compacta cada arena por turno (con su mutex y después de aplicar sus
+ *    FREE diferidos) con presupuesto K, imprimiendo el reporte de cada una.
+ */
+int arena_compact(ArenaSet* set, size_t budget);
+
+/**
+ * arena_purge:
+ *  - Comando PURGE: devuelve las páginas libres de cada arena por turno (con su mutex y después
+ *    de aplicar sus FREE diferidos) e imprime el total y el RSS del proceso antes y después.
+ *    --purge=eager vale igual en cada arena; el reloj de decay solo avanza sin arenas.
+ */
+int arena_purge(ArenaSet* set);
+
+/**
+ * arena_execute_command:
+ *  - Como mm_execute_command, desde la arena 'home'.
+ */
+int arena_execute_command(ArenaSet* set, size_t home, const Command* command);
+
+/**
+ * arena_replay:
+ *  - Lanza un hilo por cada thread_id presente en la lista; cada hilo ejecuta sus comandos en el
+ *    orden del archivo desde su arena propia y se detiene en su primer error.
+ *  - Devuelve EXIT_FAILURE si algún hilo falló.
+ */
+int arena_replay(ArenaSet* set, const CommandList* list);
+
+#endif  // ARENA_H
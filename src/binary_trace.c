@@ -0,0 +1,601 @@
+#include "binary_trace.h"
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#include "name_table.h"
+#include "parser.h"
+
+#define BINARY_TRACE_NAMES_INITIAL_CAPACITY 1024  // potencia de dos
+#define BINARY_TRACE_WRITE_BUFFER           (1 << 20)
+#define BINARY_TRACE_VARINT_MAX             10        // bytes de un varint de 64 bits
+#define BINARY_TRACE_RECORD_MAX             (1 + 3 * BINARY_TRACE_VARINT_MAX)
+
+/**
+ * Nombres vistos por el conversor: views[id] apunta al texto de entrada (mapeado, sin copias) y
+ * slots es una tabla hash (sondeo lineal) de id + 1; 0 = vacío.
+ */
+typedef struct {
+  NameView* views;
+  uint32_t  count;
+  uint32_t  views_capacity;
+  uint32_t* slots;
+  size_t    slots_capacity;
+} BinaryTraceNames;
+
+/**************************************************************************************************
+ * binary_trace_names_slot
+ *
+ *  Devuelve el slot que tiene a 'name' o, si no está, el primer slot vacío del camino.
+ */
+static size_t binary_trace_names_slot(const BinaryTraceNames* names, NameView name) {
+  size_t mask = names->slots_capacity - 1;
+  size_t i    = (size_t) name_table_hash(name.data, name.length) & mask;
+
+  while (names->slots[i] != 0) {
+    NameView stored = names->views[names->slots[i] - 1];
+    if (stored.length == name.length && memcmp(stored.data, name.data, name.length) == 0) {
+      return i;
+    }
+    i = (i + 1) & mask;
+  }
+  return i;
+}
+
+/**************************************************************************************************
+ * binary_trace_names_grow
+ *
+ *  Duplica la tabla hash y reubica todos los ids.
+ */
+static int binary_trace_names_grow(BinaryTraceNames* names) {
+  size_t    capacity = names->slots_capacity * 2;
+  uint32_t* slots    = calloc(capacity, sizeof(uint32_t));
+  if (slots == NULL) {
+    fprintf(stderr, "binary_trace_names_grow: No se pudo reservar %zu slots.\n", capacity);
+    return EXIT_FAILURE;
+  }
+
+  for (uint32_t id = 0; id < names->count; id++) {
+    NameView view = names->views[id];
+    size_t   i    = (size_t) name_table_hash(view.data, view.length) & (capacity - 1);
+    while (slots[i] != 0) {
+      i = (i + 1) & (capacity - 1);
+    }
+    slots[i] = id + 1;
+  }
+
+  free(names->slots);
+  names->slots          = slots;
+  names->slots_capacity = capacity;
+  return EXIT_SUCCESS;
+}
+
+/**************************************************************************************************
+ * binary_trace_names_id
+ *
+ *  Devuelve en 'id' el id de 'name', dándole el próximo si es la primera vez que aparece (y
+ *  entonces *added queda en true).
+ */
+static int binary_trace_names_id(BinaryTraceNames* names, NameView name, uint32_t* id,
+                                 bool* added) {
+  size_t slot = binary_trace_names_slot(names, name);
+  *added      = names->slots[slot] == 0;
+  if (!*added) {
+    *id = names->slots[slot] - 1;
+    return EXIT_SUCCESS;
+  }
+
+  if (names->count == BINARY_TRACE_MAX_NAMES) {
+    fprintf(stderr, "binary_trace_names_id: Demasiados nombres distintos.\n");
+    return EXIT_FAILURE;
+  }
+
+  if (names->count == names->views_capacity) {
+    uint32_t  capacity = names->views_capacity * 2;
+    NameView* views    = realloc(names->views, capacity * sizeof(NameView));
+    if (views == NULL) {
+      fprintf(stderr, "binary_trace_names_id: No se pudo ampliar la tabla de nombres.\n");
+      return EXIT_FAILURE;
+    }
+    names->views          = views;
+    names->views_capacity = capacity;
+  }
+
+  if ((size_t) (names->count + 1) * 4 > names->slots_capacity * 3) {
+    if (binary_trace_names_grow(names) != EXIT_SUCCESS) {
+      return EXIT_FAILURE;
+    }
+    slot = binary_trace_names_slot(names, name);
+  }
+
+  *id                        = names->count;
+  names->views[names->count] = name;
+  names->slots[slot]         = ++names->count;
+  return EXIT_SUCCESS;
+}
+
+/**************************************************************************************************
+ * binary_trace_varint_put
+ *
+ *  Escribe 'value' como varint en 'out' y devuelve cuántos bytes usó.
+ */
+static size_t binary_trace_varint_put(unsigned char* out, uint64_t value) {
+  size_t length = 0;
+  while (value >= 0x80) {
+    out[length++] = (unsigned char) (value | 0x80);
+    value       >>= 7;
+  }
+  out[length++] = (unsigned char) value;
+  return length;
+}
+
+/**************************************************************************************************
+ * binary_trace_varint_get
+ *
+ *  Lee un varint de [*cursor, end) y avanza *cursor. Devuelve false si está truncado o no entra
+ *  en 64 bits.
+ */
+static bool binary_trace_varint_get(const char** cursor, const char* end, uint64_t* value) {
+  const unsigned char* byte = (const unsigned char*) *cursor;
+  uint64_t             result = 0;
+  for (unsigned shift = 0; shift < 64 && (const char*) byte < end; shift += 7) {
+    uint64_t bits = *byte & 0x7f;
+    if (shift == 63 && bits > 1) {
+      return false;
+    }
+    result |= bits << shift;
+    if ((*byte++ & 0x80) == 0) {
+      *cursor = (const char*) byte;
+      *value  = result;
+      return true;
+    }
+  }
+  return false;
+}
+
+/**************************************************************************************************
+ * binary_trace_has_size
+ *
+ *  Tipos cuyo registro lleva el tamaño (el de los demás siempre es 0).
+ */
+static bool binary_trace_has_size(CommandType type) {
+  return type == CMD_ALLOC || type == CMD_REALLOC || type == CMD_COMPACT;
+}
+
+/**************************************************************************************************
+ * binary_trace_probe
+ */
+bool binary_trace_probe(const char* filename) {
+  // Leer de un pipe consume lo que después necesita el lector de texto: solo archivos regulares.
+  struct stat info;
+  if (stat(filename, &info) != 0 || !S_ISREG(info.st_mode)) {
+    return false;
+  }
+
+  FILE* file = fopen(filename, "rb");
+  if (file == NULL) {
+    return false;
+  }
+
+  char magic[BINARY_TRACE_MAGIC_LENGTH];
+  bool found = fread(magic, 1, sizeof(magic), file) == sizeof(magic) &&
+               memcmp(magic, BINARY_TRACE_MAGIC, BINARY_TRACE_MAGIC_LENGTH) == 0;
+  fclose(file);
+  return found;
+}
+
+/**************************************************************************************************
+ * binary_trace_decode_names
+ *
+ *  Dos pasadas por la tabla: la primera valida cada entrada y suma el largo de los nombres; la
+ *  segunda los copia a un solo bloque y arma las vistas. Un nombre solo puede compartir bytes
+ *  que el anterior tiene.
+ */
+static int binary_trace_decode_names(BinaryTrace* trace, const char* table, const char* end,
+                                     uint32_t count, const char* filename) {
+  size_t      total    = 0;
+  uint64_t    previous = 0;
+  const char* cursor   = table;
+  for (uint32_t id = 0; id < count; id++) {
+    uint64_t shared, rest;
+    if (!binary_trace_varint_get(&cursor, end, &shared) ||
+        !binary_trace_varint_get(&cursor, end, &rest) || shared > previous ||
+        rest > (uint64_t) (end - cursor)) {
+      fprintf(stderr, "binary_trace_open: Tabla de nombres inválida: %s\n", filename);
+      return EXIT_FAILURE;
+    }
+    cursor   += rest;
+    previous  = shared + rest;
+    total    += (size_t) previous;
+  }
+  if (cursor != end) {
+    fprintf(stderr, "binary_trace_open: Tabla de nombres inválida: %s\n", filename);
+    return EXIT_FAILURE;
+  }
+  if (count == 0) {
+    return EXIT_SUCCESS;
+  }
+
+  trace->names        = malloc(count * sizeof(NameView));
+  trace->name_storage = malloc(total > 0 ? total : 1);
+  if (trace->names == NULL || trace->name_storage == NULL) {
+    fprintf(stderr, "binary_trace_open: No se pudo reservar la tabla de nombres.\n");
+    return EXIT_FAILURE;
+  }
+
+  char* out = trace->name_storage;
+  cursor    = table;
+  for (uint32_t id = 0; id < count; id++) {
+    uint64_t shared, rest;
+    binary_trace_varint_get(&cursor, end, &shared);
+    binary_trace_varint_get(&cursor, end, &rest);
+    if (shared > 0) {
+      memcpy(out, trace->names[id - 1].data, (size_t) shared);
+    }
+    memcpy(out + shared, cursor, (size_t) rest);
+    trace->names[id].data   = out;
+    trace->names[id].length = (size_t) (shared + rest);
+    cursor                 += rest;
+    out                    += shared + rest;
+  }
+  return EXIT_SUCCESS;
+}
+
+/**************************************************************************************************
+ * binary_trace_open
+ *
+ *  Los registros se leen desde el mapeo a medida que se piden; solo la tabla de nombres se
+ *  decodifica en memoria: una pasada por la tabla, nunca por los registros.
+ */
+int binary_trace_open(BinaryTrace* trace, const char* filename) {
+  trace->cursor       = NULL;
+  trace->records_end  = NULL;
+  trace->record_count = 0;
+  trace->index        = 0;
+  trace->threads      = false;
+  trace->names        = NULL;
+  trace->name_storage = NULL;
+  trace->name_count   = 0;
+  trace->next_name    = 0;
+
+  if (reader_open(&trace->reader, filename) != EXIT_SUCCESS) {
+    return EXIT_FAILURE;
+  }
+
+  const Reader*     reader = &trace->reader;
+  BinaryTraceHeader header;
+  if (reader->length < sizeof(header)) {
+    fprintf(stderr, "binary_trace_open: Archivo demasiado corto: %s\n", filename);
+    reader_close(&trace->reader);
+    return EXIT_FAILURE;
+  }
+  memcpy(&header, reader->data, sizeof(header));
+
+  // Cada registro ocupa al menos un byte:
+  size_t available = reader->length - sizeof(header);
+  if (memcmp(header.magic, BINARY_TRACE_MAGIC, BINARY_TRACE_MAGIC_LENGTH) != 0 ||
+      header.names_length > available ||
+      header.record_count > available - header.names_length) {
+    fprintf(stderr, "binary_trace_open: Header inválido: %s\n", filename);
+    reader_close(&trace->reader);
+    return EXIT_FAILURE;
+  }
+
+  trace->cursor       = reader->data + sizeof(header);
+  trace->records_end  = reader->data + reader->length - header.names_length;
+  trace->record_count = header.record_count;
+  trace->threads      = (header.flags & BINARY_TRACE_THREADS) != 0;
+
+  if (binary_trace_decode_names(trace, trace->records_end, reader->data + reader->length,
+                                header.name_count, filename) != EXIT_SUCCESS) {
+    binary_trace_close(trace);
+    return EXIT_FAILURE;
+  }
+  trace->name_count = header.name_count;
+
+  return EXIT_SUCCESS;
+}
+
+/**************************************************************************************************
+ * binary_trace_close
+ */
+void binary_trace_close(BinaryTrace* trace) {
+  free(trace->names);
+  free(trace->name_storage);
+  reader_close(&trace->reader);
+  trace->cursor       = NULL;
+  trace->records_end  = NULL;
+  trace->record_count = 0;
+  trace->index        = 0;
+  trace->names        = NULL;
+  trace->name_storage = NULL;
+  trace->name_count   = 0;
+  trace->next_name    = 0;
+}
+
+/**************************************************************************************************
+ * binary_trace_next
+ */
+int binary_trace_next(BinaryTrace* trace, Command* command) {
+  size_t      index = trace->index++;
+  const char* end   = trace->records_end;
+  if (trace->cursor >= end) {
+    fprintf(stderr, "binary_trace_next: Registro %zu truncado.\n", index);
+    return EXIT_FAILURE;
+  }
+
+  unsigned op = (unsigned char) *trace->cursor++;
+  command->type        = (CommandType) (op & BINARY_TRACE_TYPE_MASK);
+  command->thread_id   = 0;
+  command->size        = 0;
+  command->name.data   = NULL;
+  command->name.length = 0;
+
+  bool named = command_has_name(command->type);
+  if ((op & ~(BINARY_TRACE_TYPE_MASK | BINARY_TRACE_NEW_NAME)) != 0 ||
+      command->type > CMD_PURGE || (!named && (op & BINARY_TRACE_NEW_NAME) != 0)) {
+    fprintf(stderr, "binary_trace_next: Tipo de comando fuera de rango en el registro %zu.\n",
+            index);
+    return EXIT_FAILURE;
+  }
+
+  uint64_t value;
+  if (named) {
+    uint64_t id = trace->next_name;
+    if (op & BINARY_TRACE_NEW_NAME) {
+      trace->next_name++;
+    } else if (!binary_trace_varint_get(&trace->cursor, end, &value)) {
+      fprintf(stderr, "binary_trace_next: Registro %zu truncado.\n", index);
+      return EXIT_FAILURE;
+    } else {
+      id = value < id ? id - 1 - value : UINT64_MAX;
+    }
+    if (id >= trace->name_count) {
+      fprintf(stderr, "binary_trace_next: Id de nombre fuera de rango en el registro %zu.\n",
+              index);
+      return EXIT_FAILURE;
+    }
+    command->name = trace->names[id];
+  }
+
+  if (binary_trace_has_size(command->type)) {
+    if (!binary_trace_varint_get(&trace->cursor, end, &value) || value > SIZE_MAX) {
+      fprintf(stderr, "binary_trace_next: Registro %zu truncado.\n", index);
+      return EXIT_FAILURE;
+    }
+    command->size = (size_t) value;
+  }
+
+  if (trace->threads) {
+    if (!binary_trace_varint_get(&trace->cursor, end, &value)) {
+      fprintf(stderr, "binary_trace_next: Registro %zu truncado.\n", index);
+      return EXIT_FAILURE;
+    }
+    if (value >= COMMAND_MAX_THREADS) {
+      fprintf(stderr, "binary_trace_next: Id de hilo fuera de rango en el registro %zu.\n",
+              index);
+      return EXIT_FAILURE;
+    }
+    command->thread_id = (unsigned) value;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+/**************************************************************************************************
+ * binary_trace_start
+ */
+int binary_trace_start(MemoryManagement* mm, const char* filename) {
+  BinaryTrace trace;
+  if (binary_trace_open(&trace, filename) != EXIT_SUCCESS) {
+    return EXIT_FAILURE;
+  }
+
+  for (size_t i = 0; i < trace.record_count; i++) {
+    Command command;
+    if (binary_trace_next(&trace, &command) != EXIT_SUCCESS) {
+      binary_trace_close(&trace);
+      return EXIT_FAILURE;
+    }
+
+    if (mm_execute_command(mm, &command) != EXIT_SUCCESS) {
+      fprintf(stderr, "binary_trace_start: Error al ejecutar el registro %zu.\n", i);
+      binary_trace_close(&trace);
+      return EXIT_FAILURE;
+    }
+  }
+
+  binary_trace_close(&trace);
+  return EXIT_SUCCESS;
+}
+
+/**************************************************************************************************
+ * binary_trace_load
+ *
+ *  Los nombres de los comandos apuntan a la tabla decodificada, que pasa a la lista; el mapeo y
+ *  las vistas de la tabla se liberan al terminar.
+ */
+int binary_trace_load(CommandList* list, const char* filename) {
+  list->commands = NULL;
+  list->count    = 0;
+  list->capacity = 0;
+  list->names    = NULL;
+  list->reader   = (Reader) {NULL, 0, 0, false};
+
+  BinaryTrace trace;
+  if (binary_trace_open(&trace, filename) != EXIT_SUCCESS) {
+    return EXIT_FAILURE;
+  }
+
+  if (trace.record_count > 0) {
+    list->commands = malloc(trace.record_count * sizeof(Command));
+    if (list->commands == NULL) {
+      fprintf(stderr, "binary_trace_load: No se pudo reservar la lista de comandos.\n");
+      binary_trace_close(&trace);
+      return EXIT_FAILURE;
+    }
+  }
+
+  for (size_t i = 0; i < trace.record_count; i++) {
+    if (binary_trace_next(&trace, &list->commands[i]) != EXIT_SUCCESS) {
+      free(list->commands);
+      list->commands = NULL;
+      binary_trace_close(&trace);
+      return EXIT_FAILURE;
+    }
+  }
+
+  list->count         = trace.record_count;
+  list->capacity      = trace.record_count;
+  list->names         = trace.name_storage;
+  trace.name_storage  = NULL;
+  binary_trace_close(&trace);
+  return EXIT_SUCCESS;
+}
+
+/**************************************************************************************************
+ * binary_trace_has_threads
+ *
+ *  Pasada previa del conversor: hay alguna línea con prefijo "T<n>"? Solo mira el primer
+ *  carácter no blanco de cada línea, sin parsear.
+ */
+static bool binary_trace_has_threads(Reader* reader) {
+  const char* line;
+  size_t      length;
+  bool        found = false;
+  while (!found && reader_next_line(reader, &line, &length)) {
+    size_t i = 0;
+    while (i < length && (line[i] == ' ' || line[i] == '\t')) {
+      i++;
+    }
+    found = i + 1 < length && line[i] == 'T' && isdigit((unsigned char) line[i + 1]);
+  }
+  reader->position = 0;
+  return found;
+}
+
+/**************************************************************************************************
+ * binary_trace_convert
+ *
+ *  1) Una pasada previa decide si los registros llevan thread_id.
+ *  2) Escribe un header provisorio y después cada registro a medida que parsea su línea.
+ *  3) Los nombres se numeran por orden de aparición; la tabla guarda vistas del texto mapeado.
+ *  4) Al final escribe la tabla de nombres (cada uno contra el anterior) y vuelve al principio a
+ *     completar el header.
+ */
+int binary_trace_convert(const char* input, const char* output) {
+  Reader reader;
+  if (reader_open(&reader, input) != EXIT_SUCCESS) {
+    fprintf(stderr, "binary_trace_convert: No se pudo abrir el archivo: %s\n", input);
+    return EXIT_FAILURE;
+  }
+
+  FILE* file = fopen(output, "wb");
+  if (file == NULL) {
+    fprintf(stderr, "binary_trace_convert: No se pudo crear el archivo: %s\n", output);
+    reader_close(&reader);
+    return EXIT_FAILURE;
+  }
+  setvbuf(file, NULL, _IOFBF, BINARY_TRACE_WRITE_BUFFER);
+
+  BinaryTraceNames names;
+  names.views          = malloc(BINARY_TRACE_NAMES_INITIAL_CAPACITY * sizeof(NameView));
+  names.count          = 0;
+  names.views_capacity = BINARY_TRACE_NAMES_INITIAL_CAPACITY;
+  names.slots          = calloc(BINARY_TRACE_NAMES_INITIAL_CAPACITY, sizeof(uint32_t));
+  names.slots_capacity = BINARY_TRACE_NAMES_INITIAL_CAPACITY;
+
+  BinaryTraceHeader header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, BINARY_TRACE_MAGIC, BINARY_TRACE_MAGIC_LENGTH);
+  header.flags = binary_trace_has_threads(&reader) ? BINARY_TRACE_THREADS : 0;
+
+  int result = EXIT_SUCCESS;
+  if (names.views == NULL || names.slots == NULL) {
+    fprintf(stderr, "binary_trace_convert: No se pudo reservar la tabla de nombres.\n");
+    result = EXIT_FAILURE;
+  } else if (fwrite(&header, sizeof(header), 1, file) != 1) {
+    result = EXIT_FAILURE;
+  }
+
+  const char* line;
+  size_t      length;
+  while (result == EXIT_SUCCESS && reader_next_line(&reader, &line, &length)) {
+    Command command;
+    if (parse_command(line, length, &command) != EXIT_SUCCESS) {
+      fprintf(stderr, "binary_trace_convert: Error al parsear comando: %.*s\n", (int) length, line);
+      result = EXIT_FAILURE;
+      break;
+    }
+
+    unsigned char record[BINARY_TRACE_RECORD_MAX];
+    size_t        record_length = 1;
+    record[0]                   = (unsigned char) command.type;
+    if (command_has_name(command.type)) {
+      uint32_t name_id;
+      bool     added;
+      if (binary_trace_names_id(&names, command.name, &name_id, &added) != EXIT_SUCCESS) {
+        result = EXIT_FAILURE;
+        break;
+      }
+      if (added) {
+        record[0] |= BINARY_TRACE_NEW_NAME;
+      } else {
+        record_length += binary_trace_varint_put(record + record_length,
+                                                 names.count - 1 - name_id);
+      }
+    }
+    if (binary_trace_has_size(command.type)) {
+      record_length += binary_trace_varint_put(record + record_length, command.size);
+    }
+    if (header.flags & BINARY_TRACE_THREADS) {
+      record_length += binary_trace_varint_put(record + record_length, command.thread_id);
+    }
+    if (fwrite(record, 1, record_length, file) != record_length) {
+      result = EXIT_FAILURE;
+      break;
+    }
+    header.record_count++;
+  }
+
+  NameView previous = {NULL, 0};
+  for (uint32_t id = 0; result == EXIT_SUCCESS && id < names.count; id++) {
+    NameView view   = names.views[id];
+    size_t   shared = 0;
+    while (shared < view.length && shared < previous.length &&
+           view.data[shared] == previous.data[shared]) {
+      shared++;
+    }
+
+    unsigned char prefix[2 * BINARY_TRACE_VARINT_MAX];
+    size_t        prefix_length = binary_trace_varint_put(prefix, shared);
+    prefix_length += binary_trace_varint_put(prefix + prefix_length, view.length - shared);
+    if (fwrite(prefix, 1, prefix_length, file) != prefix_length ||
+        fwrite(view.data + shared, 1, view.length - shared, file) != view.length - shared) {
+      result = EXIT_FAILURE;
+    }
+    header.names_length += prefix_length + view.length - shared;
+    previous             = view;
+  }
+  header.name_count = names.count;
+
+  if (result == EXIT_SUCCESS &&
+      (fseek(file, 0, SEEK_SET) != 0 || fwrite(&header, sizeof(header), 1, file) != 1)) {
+    result = EXIT_FAILURE;
+  }
+  if (fclose(file) != 0) {
+    result = EXIT_FAILURE;
+  }
+  if (result != EXIT_SUCCESS) {
+    fprintf(stderr, "binary_trace_convert: No se pudo generar la traza: %s\n", output);
+    remove(output);
+  }
+
+  free(names.views);
+  free(names.slots);
+  reader_close(&reader);
+  return result;
+}
@@ -0,0 +1,121 @@
+// binary_trace.h
+
+#ifndef BINARY_TRACE_H
+#define BINARY_TRACE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "command.h"
+#include "command_list.h"
+#include "memory_management.h"
+#include "name_view.h"
+#include "reader.h"
+
+#define BINARY_TRACE_MAGIC        "MMTRACE3"
+#define BINARY_TRACE_MAGIC_LENGTH 8
+#define BINARY_TRACE_THREADS      1u            // flag: los registros llevan thread_id
+#define BINARY_TRACE_TYPE_MASK    0x07u         // bits del byte de op para el CommandType
+#define BINARY_TRACE_NEW_NAME     0x08u         // bit del byte de op: nombre nuevo, sin id
+#define BINARY_TRACE_MAX_NAMES    (1u << 31)    // la tabla del conversor duplica un uint32_t
+
+/**
+ * Formato binario de trazas:
+ *
+ *   [BinaryTraceHeader][record_count registros][tabla de nombres (names_length bytes)]
+ *
+ * Los enteros de los registros y de la tabla son varints (7 bits por byte, el menos
+ * significativo primero, bit alto = sigue otro byte). Un registro es:
+ *  - un byte de op: bits 0-2 el CommandType y BINARY_TRACE_NEW_NAME; el resto en cero
+ *  - con nombre (ver command_has_name): nada si es BINARY_TRACE_NEW_NAME (el id es el siguiente
+ *    al último nombre nuevo) y si no el varint (último id nuevo - id), que es chico para los
+ *    nombres recientes
+ *  - en ALLOC, REALLOC y COMPACT: el varint del tamaño
+ *  - si flags tiene BINARY_TRACE_THREADS: el varint del thread_id
+ * Los nombres se numeran por orden de aparición. La tabla los trae en ese orden y con
+ * codificación por prefijo: cuántos bytes comparte con el nombre anterior y el varint del largo
+ * del resto, seguido del resto. Va al final para que el conversor pueda escribir los registros
+ * a medida que los lee, sin tener la traza entera en memoria.
+ *
+ * Los registros son de ancho variable: con un nombre distinto por objeto (como las trazas de
+ * tracegen) los de ancho fijo apenas achicaban el texto, porque se los llevaban el id y la tabla
+ * de nombres. Se leen en orden, sin índice.
+ */
+typedef struct {
+  char     magic[BINARY_TRACE_MAGIC_LENGTH];
+  uint64_t record_count;
+  uint64_t names_length;  // bytes de la tabla de nombres
+  uint32_t name_count;
+  uint32_t flags;
+} BinaryTraceHeader;
+
+/**
+ * Traza binaria abierta:
+ *  - reader: el archivo mapeado; cursor / records_end recorren sus registros
+ *  - record_count / index: registros en total / ya leídos por binary_trace_next
+ *  - threads: los registros llevan thread_id
+ *  - names / name_count: vista de cada nombre, indexada por id, sobre name_storage (la tabla
+ *    decodificada, un solo bloque de malloc)
+ *  - next_name: id que toma el próximo registro con BINARY_TRACE_NEW_NAME
+ */
+typedef struct {
+  Reader      reader;
+  const char* cursor;
+  const char* records_end;
+  size_t      record_count;
+  size_t      index;
+  bool        threads;
+  NameView*   names;
+  char*       name_storage;
+  uint32_t    name_count;
+  uint32_t    next_name;
+} BinaryTrace;
+
+/**
+ * binary_trace_probe:
+ *  - true si 'filename' es un archivo regular que empieza con BINARY_TRACE_MAGIC. Un pipe no se
+ *    lee (se trata como texto).
+ */
+bool binary_trace_probe(const char* filename);
+
+/**
+ * binary_trace_open / binary_trace_close:
+ *  - Mapea 'filename', valida el header y decodifica la tabla de nombres.
+ *  - binary_trace_open devuelve EXIT_FAILURE, sin dejar nada reservado, si el archivo no es una
+ *    traza binaria válida.
+ */
+int binary_trace_open(BinaryTrace* trace, const char* filename);
+void binary_trace_close(BinaryTrace* trace);
+
+/**
+ * binary_trace_next:
+ *  - Arma en 'command' el próximo registro (el nombre es una vista de name_storage, sin copias).
+ *    Se llama record_count veces.
+ *  - Devuelve EXIT_FAILURE si el registro está truncado o tiene un tipo, un id de nombre o un
+ *    thread_id fuera de rango.
+ */
+int binary_trace_next(BinaryTrace* trace, Command* command);
+
+/**
+ * binary_trace_start:
+ *  - Equivalente a mm_start para trazas binarias: ejecuta cada registro con mm_execute_command,
+ *    sin tokenizar, y se detiene en el primer error.
+ */
+int binary_trace_start(MemoryManagement* mm, const char* filename);
+
+/**
+ * binary_trace_load:
+ *  - Equivalente a command_list_load para trazas binarias (para repetirlas con arenas). La lista
+ *    se queda con la tabla de nombres decodificada (CommandList::names) y no con el archivo.
+ */
+int binary_trace_load(CommandList* list, const char* filename);
+
+/**
+ * binary_trace_convert:
+ *  - Convierte el archivo de comandos de texto 'input' (mismas reglas que mm_start) a una traza
+ *    binaria en 'output'. Falla si hay más de BINARY_TRACE_MAX_NAMES nombres distintos.
+ */
+int binary_trace_convert(const char* input, const char* output);
+
+#endif  // BINARY_TRACE_H
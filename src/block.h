@@ -0,0 +1,83 @@
+// block.h
+
+#ifndef BLOCK_H
+#define BLOCK_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define BLOCK_NAME_INLINE 16  // bytes del nombre guardados dentro del Block
+
+/**
+ * Nombre de variable de un bloque, sin memoria propia en el heap:
+ *  - inline_name[0] != '\0' ⇾ nombre corto (hasta BLOCK_NAME_INLINE - 1 caracteres) guardado
+ *                             en el mismo Block, completado con '\0'.
+ *  - inline_name[0] == '\0' ⇾ interned.id identifica un nombre largo en la NameTable
+ *                             (ver name_table.h); id == 0 significa “sin nombre” (bloque libre).
+ *
+ * Todos los bytes no usados quedan en cero, así que dos nombres son iguales si y solo si sus
+ * BLOCK_NAME_INLINE bytes son iguales.
+ */
+typedef union {
+  char inline_name[BLOCK_NAME_INLINE];
+  struct {
+    char     tag;  // siempre '\0'
+    uint32_t id;
+  } interned;
+} BlockName;
+
+/**
+ * Páginas de un bloque libre que quedaron tocadas (residentes) y todavía no se devolvieron al SO
+ * con madvise (ver purge.h):
+ *  - since: purge_clock del FREE más antiguo que dejó páginas sucias; 0 = limpio (páginas ya
+ *           devueltas o nunca tocadas) y entonces start / end no se usan
+ *  - start / end: tramo [start, end) de offsets que cubre todo lo sucio del bloque
+ */
+typedef struct {
+  size_t since;
+  size_t start;
+  size_t end;
+} BlockDirty;
+
+/**
+ * Estado de un bloque para los FREE por handle de las arenas (ver arena.h), que llegan desde
+ * otros hilos sin el mutex del dueño. Solo el que gana el CAS desde BLOCK_LIVE puede tocar los
+ * enlaces del bloque:
+ *  - BLOCK_RELEASED: libre, en la caché de --cache o nodo del pool (cualquier cosa no viva)
+ *  - BLOCK_LIVE:     asignado por ALLOC o REALLOC
+ *  - BLOCK_PENDING:  con un FREE remoto encolado en remote_frees, hasta que el dueño lo aplica
+ */
+typedef enum { BLOCK_RELEASED, BLOCK_LIVE, BLOCK_PENDING } BlockState;
+
+/**
+ * Cada bloque de la lista representa:
+ *  - free == true  ⇾ un trozo libre de 'size' bytes a partir de 'offset' bytes desde memory_region.
+ *  - free == false ⇾ un trozo ocupado con nombre 'name', 'size' bytes, en 'offset' bytes desde memory_region.
+ *
+ * Los bloques libres además están enlazados (next_free / prev_free) en la lista segregada
+ * de su clase de tamaño (ver free_lists.h) y son nodos del árbol por tamaño (ver free_tree.h).
+ * Los ocupados están encadenados (name_next / name_prev) con los demás bloques de su mismo
+ * nombre en el índice de nombres (ver name_index.h).
+ */
+typedef struct Block {
+  bool           free;       // true = disponible, false = ocupado
+  BlockName      name;       // nombre de variable (p.ej. "A", "B", …); vacío si libre
+  size_t         size;       // número de bytes que ocupa este bloque
+  size_t         requested;  // bytes pedidos por ALLOC/REALLOC (<= size); 0 si libre
+  size_t         offset;     // desplazamiento (en bytes) desde memory_region
+  struct Block*  next;       // siguiente bloque en la lista
+  struct Block*  prev;       // bloque anterior en la lista
+  struct Block*  next_free;  // siguiente bloque libre de la misma clase de tamaño
+  struct Block*  prev_free;  // bloque libre anterior de la misma clase de tamaño
+  struct Block*  tree_left;  // hijo izquierdo en el árbol de libres (menor (size, offset))
+  struct Block*  tree_right; // hijo derecho en el árbol de libres (mayor (size, offset))
+  int            tree_height;// altura del subárbol (AVL)
+  BlockDirty     dirty;      // libre: tramo con páginas tocadas sin devolver (ver purge.h)
+  struct Block*  name_next;  // siguiente bloque ocupado con el mismo nombre
+  struct Block*  name_prev;  // bloque ocupado anterior con el mismo nombre
+  atomic_int     state;      // BlockState; solo lo leen con CAS los FREE por handle
+} Block;
+
+#endif  // BLOCK_H
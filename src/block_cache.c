@@ -0,0 +1,45 @@
+#include "block_cache.h"
+
+/**************************************************************************************************
+ * block_cache_init
+ */
+void block_cache_init(BlockCache* cache) {
+  for (size_t i = 0; i <= BLOCK_CACHE_MAX_SIZE; i++) {
+    cache->heads[i]  = NULL;
+    cache->counts[i] = 0;
+  }
+  cache->blocks = 0;
+}
+
+/**************************************************************************************************
+ * block_cache_fits
+ */
+bool block_cache_fits(size_t size) {
+  return size > 0 && size <= BLOCK_CACHE_MAX_SIZE;
+}
+
+/**************************************************************************************************
+ * block_cache_push
+ */
+void block_cache_push(BlockCache* cache, Block* block) {
+  block->next_free          = cache->heads[block->size];
+  cache->heads[block->size] = block;
+  cache->counts[block->size]++;
+  cache->blocks++;
+}
+
+/**************************************************************************************************
+ * block_cache_pop
+ */
+Block* block_cache_pop(BlockCache* cache, size_t size) {
+  Block* block = cache->heads[size];
+  if (block == NULL) {
+    return NULL;
+  }
+
+  cache->heads[size] = block->next_free;
+  cache->counts[size]--;
+  cache->blocks--;
+  block->next_free = NULL;
+  return block;
+}
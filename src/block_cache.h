@@ -0,0 +1,53 @@
+// block_cache.h
+
+#ifndef BLOCK_CACHE_H
+#define BLOCK_CACHE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "block.h"
+
+#define BLOCK_CACHE_MAX_SIZE      1024  // solo bloques de hasta 1 KB pasan por la caché
+#define BLOCK_CACHE_DEFAULT_COUNT 7     // bloques por tamaño con --cache sin N (como tcache)
+
+/**
+ * Caché de reuso rápido (--cache[=N]), una pila LIFO por tamaño exacto:
+ *  - heads[s]: bloques de exactamente s bytes que FREE dejó sin unir con sus vecinos, el último
+ *              liberado primero; se enlazan por next_free (no están en los índices de libres).
+ *  - counts[s]: largo de heads[s], acotado por options.cache_count.
+ *  - blocks: bloques en toda la caché, para saber sin recorrerla si está vacía.
+ *
+ * Un bloque en la caché sigue en la lista por dirección como ocupado y sin nombre: para
+ * mm_free_join no es un vecino libre, y un ALLOC del mismo tamaño lo recibe en O(1) sin buscar
+ * ni partir nada (ver mm_cache_flush para cuándo se devuelve a los libres).
+ */
+typedef struct {
+  Block*   heads[BLOCK_CACHE_MAX_SIZE + 1];
+  uint32_t counts[BLOCK_CACHE_MAX_SIZE + 1];
+  size_t   blocks;
+} BlockCache;
+
+/**
+ * block_cache_init:
+ *  - Deja todas las pilas vacías.
+ */
+void block_cache_init(BlockCache* cache);
+
+/**
+ * block_cache_fits:
+ *  - Indica si un bloque de 'size' bytes tiene pila propia (1 <= size <= BLOCK_CACHE_MAX_SIZE).
+ */
+bool block_cache_fits(size_t size);
+
+/**
+ * block_cache_push / block_cache_pop:
+ *  - Apilan un bloque en la pila de su tamaño o sacan el último apilado de 'size' bytes (NULL si
+ *    está vacía). 'size' debe cumplir block_cache_fits; el límite de cada pila lo controla quien
+ *    llama.
+ */
+void   block_cache_push(BlockCache* cache, Block* block);
+Block* block_cache_pop(BlockCache* cache, size_t size);
+
+#endif  // BLOCK_CACHE_H
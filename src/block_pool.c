@@ -0,0 +1,93 @@
+#include "block_pool.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/**************************************************************************************************
+ * block_pool_init
+ */
+void block_pool_init(BlockPool* pool) {
+  pool->slabs          = NULL;
+  pool->free_list      = NULL;
+  pool->live           = 0;
+  pool->high_water     = 0;
+  pool->metadata_bytes = 0;
+  pool->acquires       = 0;
+  pool->releases       = 0;
+}
+
+/**************************************************************************************************
+ * block_pool_grow
+ *
+ *  Reserva un slab nuevo y encadena todos sus nodos en la free_list, en orden de dirección para
+ *  que nodos consecutivos de la lista de bloques tiendan a quedar contiguos en memoria.
+ */
+static int block_pool_grow(BlockPool* pool) {
+  BlockSlab* slab = (BlockSlab*) malloc(sizeof(BlockSlab));
+  if (slab == NULL) {
+    fprintf(stderr, "block_pool_grow: No se pudo reservar un slab de %zu bytes.\n", sizeof(BlockSlab));
+    return EXIT_FAILURE;
+  }
+
+  for (size_t i = 0; i < BLOCK_POOL_SLAB_BLOCKS - 1; i++) {
+    slab->blocks[i].next = &slab->blocks[i + 1];
+  }
+  for (size_t i = 0; i < BLOCK_POOL_SLAB_BLOCKS; i++) {
+    atomic_init(&slab->blocks[i].state, BLOCK_RELEASED);
+  }
+  slab->blocks[BLOCK_POOL_SLAB_BLOCKS - 1].next = pool->free_list;
+
+  pool->free_list = &slab->blocks[0];
+  slab->next      = pool->slabs;
+  pool->slabs     = slab;
+  pool->metadata_bytes += sizeof(BlockSlab);
+  return EXIT_SUCCESS;
+}
+
+/**************************************************************************************************
+ * block_pool_acquire
+ *
+ *  Saca el primer nodo de la free_list; solo toca malloc cuando el pool se agotó.
+ */
+Block* block_pool_acquire(BlockPool* pool) {
+  if (pool->free_list == NULL && block_pool_grow(pool) != EXIT_SUCCESS) {
+    return NULL;
+  }
+
+  Block* block    = pool->free_list;
+  pool->free_list = block->next;
+
+  pool->live++;
+  pool->acquires++;
+  if (pool->live > pool->high_water) {
+    pool->high_water = pool->live;
+  }
+  return block;
+}
+
+/**************************************************************************************************
+ * block_pool_release
+ */
+void block_pool_release(BlockPool* pool, Block* block) {
+  atomic_store_explicit(&block->state, BLOCK_RELEASED, memory_order_relaxed);
+  block->next     = pool->free_list;
+  pool->free_list = block;
+  pool->live--;
+  pool->releases++;
+}
+
+/**************************************************************************************************
+ * block_pool_destroy
+ */
+void block_pool_destroy(BlockPool* pool) {
+  BlockSlab* slab = pool->slabs;
+  while (slab != NULL) {
+    BlockSlab* next = slab->next;
+    free(slab);
+    slab = next;
+  }
+
+  pool->slabs     = NULL;
+  pool->free_list = NULL;
+  pool->live      = 0;
+}
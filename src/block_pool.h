@@ -0,0 +1,65 @@
+// block_pool.h
+
+#ifndef BLOCK_POOL_H
+#define BLOCK_POOL_H
+
+#include <stddef.h>
+
+#include "block.h"
+
+#define BLOCK_POOL_SLAB_BLOCKS 512  // nodos Block por slab
+
+/**
+ * Un slab: un único malloc con BLOCK_POOL_SLAB_BLOCKS nodos contiguos.
+ * Los slabs se encadenan para poder liberarlos todos juntos.
+ */
+typedef struct BlockSlab {
+  struct BlockSlab* next;
+  Block             blocks[BLOCK_POOL_SLAB_BLOCKS];
+} BlockSlab;
+
+/**
+ * Pool de nodos Block:
+ *  - slabs: lista de slabs reservados
+ *  - free_list: nodos disponibles, enlazados a través de Block::next (lista intrusiva)
+ *  - live: nodos entregados y aún no devueltos
+ *  - high_water: máximo histórico de live
+ *  - metadata_bytes: bytes pedidos al sistema para slabs
+ *  - acquires / releases: nodos entregados y devueltos en total (cada split y cada merge de la
+ *    lista de bloques cuesta uno)
+ */
+typedef struct {
+  BlockSlab* slabs;
+  Block*     free_list;
+  size_t     live;
+  size_t     high_water;
+  size_t     metadata_bytes;
+  size_t     acquires;
+  size_t     releases;
+} BlockPool;
+
+/**
+ * block_pool_init:
+ *  - Deja el pool vacío (el primer slab se reserva en el primer block_pool_acquire).
+ */
+void block_pool_init(BlockPool* pool);
+
+/**
+ * block_pool_acquire:
+ *  - Devuelve un nodo sin inicializar, o NULL si hacía falta un slab nuevo y malloc falló.
+ */
+Block* block_pool_acquire(BlockPool* pool);
+
+/**
+ * block_pool_release:
+ *  - Devuelve el nodo a la free_list del pool (no llama a free).
+ */
+void block_pool_release(BlockPool* pool, Block* block);
+
+/**
+ * block_pool_destroy:
+ *  - Libera todos los slabs de una vez; los nodos entregados dejan de ser válidos.
+ */
+void block_pool_destroy(BlockPool* pool);
+
+#endif  // BLOCK_POOL_H
@@ -0,0 +1,454 @@
+#include "boundary_tags.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "tags_index.h"
+
+#define TAGS_FREE_BIT ((size_t) 1)
+
+/**
+ * Header en banda al inicio de cada chunk. name queda vacío en los chunks libres.
+ */
+typedef struct {
+  size_t    tag;   // size | TAGS_FREE_BIT
+  BlockName name;
+} TagHeader;
+
+/**
+ * Enlaces de la lista de libres, guardados en el payload de un chunk libre.
+ */
+typedef struct {
+  size_t next;
+  size_t prev;
+} TagLinks;
+
+#define TAGS_OVERHEAD  (sizeof(TagHeader) + sizeof(size_t))    // header + footer
+#define TAGS_MIN_CHUNK (TAGS_OVERHEAD + sizeof(TagLinks))       // un chunk libre debe caber
+
+/**************************************************************************************************
+ * Acceso a los tags
+ *
+ *  Todos los offsets de chunk son múltiplos de TAGS_ALIGN y memory_region sale de region_map,
+ *  alineada a página (con --arenas, cada arena empieza en un múltiplo de ARENA_ALIGN), así que
+ *  los accesos quedan alineados.
+ */
+static TagHeader* tags_header(const MemoryManagement* mm, size_t offset) {
+  return (TagHeader*) ((char*) mm->memory_region + offset);
+}
+
+static TagLinks* tags_links(const MemoryManagement* mm, size_t offset) {
+  return (TagLinks*) ((char*) mm->memory_region + offset + sizeof(TagHeader));
+}
+
+static size_t tags_size(const MemoryManagement* mm, size_t offset) {
+  return tags_header(mm, offset)->tag & ~TAGS_FREE_BIT;
+}
+
+static bool tags_is_free(const MemoryManagement* mm, size_t offset) {
+  return (tags_header(mm, offset)->tag & TAGS_FREE_BIT) != 0;
+}
+
+/**************************************************************************************************
+ * tags_write
+ *
+ *  Escribe header y footer de un chunk con el mismo tag.
+ */
+static void tags_write(MemoryManagement* mm, size_t offset, size_t size, bool free) {
+  size_t tag = size | (free ? TAGS_FREE_BIT : 0);
+  tags_header(mm, offset)->tag = tag;
+  *(size_t*) ((char*) mm->memory_region + offset + size - sizeof(size_t)) = tag;
+}
+
+/**************************************************************************************************
+ * tags_list_insert / tags_list_remove
+ *
+ *  Lista doblemente enlazada (LIFO) de chunks libres, con los enlaces en su propio payload.
+ *  Quitar el chunk al que apunta tags_rover deja el cursor en el siguiente de la lista.
+ */
+static void tags_list_insert(MemoryManagement* mm, size_t offset) {
+  TagLinks* links = tags_links(mm, offset);
+  links->prev     = TAGS_NONE;
+  links->next     = mm->tags_free_head;
+  if (mm->tags_free_head != TAGS_NONE) {
+    tags_links(mm, mm->tags_free_head)->prev = offset;
+  }
+  mm->tags_free_head = offset;
+
+  mm->stats.free_bytes += tags_size(mm, offset);
+  mm->stats.free_blocks++;
+  mm->stats.live_bytes -= tags_size(mm, offset);
+}
+
+static void tags_list_remove(MemoryManagement* mm, size_t offset) {
+  TagLinks* links = tags_links(mm, offset);
+  if (links->prev != TAGS_NONE) {
+    tags_links(mm, links->prev)->next = links->next;
+  } else {
+    mm->tags_free_head = links->next;
+  }
+  if (links->next != TAGS_NONE) {
+    tags_links(mm, links->next)->prev = links->prev;
+  }
+  if (mm->tags_rover == offset) {
+    mm->tags_rover = links->next;
+  }
+
+  mm->stats.free_bytes -= tags_size(mm, offset);
+  mm->stats.free_blocks--;
+  mm->stats.live_bytes += tags_size(mm, offset);
+}
+
+/**************************************************************************************************
+ * tags_chunk_size
+ *
+ *  Tamaño de chunk para 'size' bytes de payload: alineado y nunca menor que TAGS_MIN_CHUNK.
+ *  Devuelve 0 si no se puede representar.
+ */
+static size_t tags_chunk_size(size_t size) {
+  if (size > SIZE_MAX - TAGS_OVERHEAD - TAGS_ALIGN) {
+    return 0;
+  }
+  size_t chunk = (size + TAGS_OVERHEAD + TAGS_ALIGN - 1) & ~(size_t) (TAGS_ALIGN - 1);
+  return chunk < TAGS_MIN_CHUNK ? TAGS_MIN_CHUNK : chunk;
+}
+
+/**************************************************************************************************
+ * tags_find_free
+ *
+ *  Recorre la lista de libres según mm->strategy. NEXT arranca en tags_rover, da una vuelta y
+ *  deja el cursor en el chunk encontrado.
+ */
+static size_t tags_find_free(MemoryManagement* mm, size_t chunk) {
+  size_t found = TAGS_NONE;
+  mm->searches++;
+
+  if (mm->strategy == STRATEGY_NEXT) {
+    size_t start = mm->tags_rover != TAGS_NONE ? mm->tags_rover : mm->tags_free_head;
+    size_t current = start;
+    while (current != TAGS_NONE) {
+      mm->search_steps++;
+      if (tags_size(mm, current) >= chunk) {
+        mm->tags_rover = current;
+        return current;
+      }
+      current = tags_links(mm, current)->next;
+      if (current == TAGS_NONE) {
+        current = mm->tags_free_head;
+      }
+      if (current == start) {
+        break;
+      }
+    }
+    return TAGS_NONE;
+  }
+
+  for (size_t current = mm->tags_free_head; current != TAGS_NONE;
+       current = tags_links(mm, current)->next) {
+    mm->search_steps++;
+    size_t size = tags_size(mm, current);
+    if (size < chunk) {
+      continue;
+    }
+    if (mm->strategy == STRATEGY_FIRST) {
+      return current;
+    }
+    if (found == TAGS_NONE ||
+        (mm->strategy == STRATEGY_BEST && size < tags_size(mm, found)) ||
+        (mm->strategy == STRATEGY_WORST && size > tags_size(mm, found))) {
+      found = current;
+    }
+  }
+  return found;
+}
+
+/**************************************************************************************************
+ * tags_release
+ *
+ *  Marca libre el chunk [offset, offset + size), lo une con sus vecinos libres leyendo el header
+ *  del derecho y el footer del izquierdo (O(1), sin recorrer nada) y lo agrega a la lista.
+ */
+static void tags_release(MemoryManagement* mm, size_t offset, size_t size) {
+  size_t next = offset + size;
+  if (next < mm->tags_end && tags_is_free(mm, next)) {
+    tags_list_remove(mm, next);
+    size += tags_size(mm, next);
+    mm->stats.merges++;
+  }
+
+  if (offset > 0) {
+    size_t prev_tag = *(size_t*) ((char*) mm->memory_region + offset - sizeof(size_t));
+    if ((prev_tag & TAGS_FREE_BIT) != 0) {
+      size_t prev_size = prev_tag & ~TAGS_FREE_BIT;
+      offset -= prev_size;
+      size   += prev_size;
+      tags_list_remove(mm, offset);
+      mm->stats.merges++;
+    }
+  }
+
+  tags_write(mm, offset, size, true);
+  block_name_clear(&tags_header(mm, offset)->name);
+  tags_list_insert(mm, offset);
+}
+
+/**************************************************************************************************
+ * tags_split
+ *
+ *  Deja el chunk ocupado en 'offset' con 'chunk' bytes y devuelve el resto como chunk libre,
+ *  si alcanza para uno. El nombre del header no se toca.
+ */
+static void tags_split(MemoryManagement* mm, size_t offset, size_t size, size_t chunk) {
+  if (size - chunk < TAGS_MIN_CHUNK) {
+    tags_write(mm, offset, size, false);
+    return;
+  }
+  tags_write(mm, offset, chunk, false);
+  tags_release(mm, offset + chunk, size - chunk);
+  mm->stats.splits++;
+}
+
+/**************************************************************************************************
+ * tags_find_named
+ *
+ *  Devuelve el chunk ocupado con ese nombre y menor offset (por tags_names, sin recorrer los
+ *  chunks), o TAGS_NONE.
+ */
+static size_t tags_find_named(const MemoryManagement* mm, const BlockName* name) {
+  size_t offset;
+  return tags_index_find(&mm->tags_names, name, &offset) ? offset : TAGS_NONE;
+}
+
+/**************************************************************************************************
+ * tags_fill
+ *
+ *  Rellena 'size' bytes de payload con la primera letra del nombre del chunk.
+ */
+static void tags_fill(MemoryManagement* mm, size_t offset, size_t size) {
+  memset(
+    (char*)mm->memory_region + offset + sizeof(TagHeader),
+    name_table_str(&mm->name_table, &tags_header(mm, offset)->name)[0],
+    size
+  );
+}
+
+/**************************************************************************************************
+ * mm_tags_init
+ */
+int mm_tags_init(MemoryManagement* mm) {
+  mm->tags_end       = mm->total_size & ~(size_t) (TAGS_ALIGN - 1);
+  mm->tags_free_head = TAGS_NONE;
+  mm->tags_rover     = TAGS_NONE;
+  if (tags_index_init(&mm->tags_names) != EXIT_SUCCESS) {
+    return EXIT_FAILURE;
+  }
+
+  if (mm->tags_end < TAGS_MIN_CHUNK) {
+    fprintf(stderr, "mm_tags_init: La región de %zu bytes no alcanza para un chunk.\n",
+            mm->total_size);
+    return EXIT_FAILURE;
+  }
+
+  // La cola que no llega a TAGS_ALIGN no es de ningún chunk:
+  mm->stats.lost_bytes = mm->total_size - mm->tags_end;
+  mm->stats.live_bytes = mm->tags_end;
+
+  tags_write(mm, 0, mm->tags_end, true);
+  block_name_clear(&tags_header(mm, 0)->name);
+  tags_list_insert(mm, 0);
+  return EXIT_SUCCESS;
+}
+
+/**************************************************************************************************
+ * tags_alloc
+ *
+ *  Cuerpo de mm_tags_alloc: devuelve el offset del chunk entregado, o TAGS_NONE.
+ */
+static size_t tags_alloc(MemoryManagement* mm, const BlockName* name, size_t size,
+                         bool* no_room) {
+  size_t chunk  = tags_chunk_size(size);
+  size_t offset = chunk != 0 ? tags_find_free(mm, chunk) : TAGS_NONE;
+  if (offset == TAGS_NONE && no_room != NULL) {
+    *no_room = true;
+    return TAGS_NONE;
+  }
+  if (offset == TAGS_NONE) {
+    fprintf(stderr,
+            "mm_tags_alloc: No se encontró bloque suficiente (se solicitó %zu bytes) para %s.\n",
+            size, name_table_str(&mm->name_table, name));
+    return TAGS_NONE;
+  }
+
+  tags_list_remove(mm, offset);
+  tags_header(mm, offset)->name = *name;
+  tags_split(mm, offset, tags_size(mm, offset), chunk);
+  if (tags_index_insert(&mm->tags_names, name, offset) != EXIT_SUCCESS) {
+    tags_release(mm, offset, tags_size(mm, offset));
+    return TAGS_NONE;
+  }
+
+  tags_fill(mm, offset, size);
+  return offset;
+}
+
+/**************************************************************************************************
+ * mm_tags_alloc
+ */
+int mm_tags_alloc(MemoryManagement* mm, const BlockName* name, size_t size, bool* no_room) {
+  return tags_alloc(mm, name, size, no_room) != TAGS_NONE ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/**************************************************************************************************
+ * tags_relocate
+ *
+ *  REALLOC que se muda (--realloc=move): asigna otro chunk con el mismo nombre, copia el payload
+ *  del viejo y lo libera.
+ */
+static int tags_relocate(MemoryManagement* mm, size_t offset, size_t current, size_t size) {
+  BlockName block_name = tags_header(mm, offset)->name;
+  size_t    moved      = tags_alloc(mm, &block_name, size, NULL);
+  if (moved == TAGS_NONE) {
+    return EXIT_FAILURE;
+  }
+
+  size_t payload = current - TAGS_OVERHEAD;
+  memcpy((char*)mm->memory_region + moved + sizeof(TagHeader),
+         (char*)mm->memory_region + offset + sizeof(TagHeader), payload);
+  mm->stats.moves++;
+  mm->stats.moved_bytes += payload;
+
+  tags_index_remove(&mm->tags_names, &block_name, offset);
+  tags_release(mm, offset, current);
+  return EXIT_SUCCESS;
+}
+
+/**************************************************************************************************
+ * mm_tags_realloc
+ *
+ *  Achicar devuelve el resto (que se une con un vecino derecho libre); crecer absorbe el vecino
+ *  derecho si está libre y alcanza. Si no, “simula fuga” como mm_realloc; con --realloc=move,
+ *  en cambio, se une también con el vecino izquierdo o se muda (ver mm_realloc_move).
+ */
+int mm_tags_realloc(MemoryManagement* mm, const BlockName* name, size_t size) {
+  size_t offset = tags_find_named(mm, name);
+  if (offset == TAGS_NONE) {
+    fprintf(stderr, "mm_tags_realloc: No se encontró bloque con nombre %s.\n",
+            name_table_str(&mm->name_table, name));
+    return EXIT_FAILURE;
+  }
+
+  size_t chunk   = tags_chunk_size(size);
+  size_t current = tags_size(mm, offset);
+  if (chunk == 0) {
+    fprintf(stderr, "mm_tags_realloc: Tamaño %zu no representable.\n", size);
+    return EXIT_FAILURE;
+  }
+
+  if (chunk > current) {
+    size_t next      = offset + current;
+    size_t next_size = next < mm->tags_end && tags_is_free(mm, next) ? tags_size(mm, next) : 0;
+    if (current + next_size >= chunk) {
+      tags_list_remove(mm, next);
+      current += next_size;
+      mm->stats.merges++;
+    } else if (!mm->options.realloc_move) {
+      BlockName block_name = *name;
+      if (mm_tags_alloc(mm, &block_name, size, NULL) != EXIT_SUCCESS) {
+        return EXIT_FAILURE;
+      }
+      mm->stats.leaks++;
+      mm->stats.leaked_bytes += current;
+      return EXIT_SUCCESS;
+    } else {
+      // Con --realloc=move: el vecino izquierdo (por su footer) y el derecho, o mudarse.
+      size_t prev_size = 0;
+      if (offset > 0) {
+        size_t prev_tag = *(size_t*) ((char*) mm->memory_region + offset - sizeof(size_t));
+        prev_size       = (prev_tag & TAGS_FREE_BIT) != 0 ? prev_tag & ~TAGS_FREE_BIT : 0;
+      }
+      if (prev_size == 0 || prev_size + current + next_size < chunk) {
+        return tags_relocate(mm, offset, current, size);
+      }
+
+      if (next_size > 0) {
+        tags_list_remove(mm, next);
+        mm->stats.merges++;
+      }
+      tags_list_remove(mm, offset - prev_size);
+      mm->stats.merges++;
+      // Header y payload bajan juntos; tags_split reescribe el tag y el footer.
+      memmove((char*)mm->memory_region + offset - prev_size,
+              (char*)mm->memory_region + offset, current - sizeof(size_t));
+      tags_index_move(&mm->tags_names, name, offset, offset - prev_size);
+      offset  -= prev_size;
+      current += prev_size + next_size;
+    }
+  }
+
+  tags_split(mm, offset, current, chunk);
+  tags_fill(mm, offset, size);
+  return EXIT_SUCCESS;
+}
+
+/**************************************************************************************************
+ * mm_tags_free
+ */
+int mm_tags_free(MemoryManagement* mm, const BlockName* name) {
+  size_t offset = tags_find_named(mm, name);
+  if (offset == TAGS_NONE) {
+    fprintf(stderr, "mm_tags_free: No se encontró bloque con nombre %s.\n",
+            name_table_str(&mm->name_table, name));
+    return EXIT_FAILURE;
+  }
+
+  tags_index_remove(&mm->tags_names, name, offset);
+  tags_release(mm, offset, tags_size(mm, offset));
+  return EXIT_SUCCESS;
+}
+
+/**************************************************************************************************
+ * mm_tags_contains
+ */
+bool mm_tags_contains(const MemoryManagement* mm, const BlockName* name) {
+  return tags_find_named(mm, name) != TAGS_NONE;
+}
+
+/**************************************************************************************************
+ * mm_tags_largest_free
+ */
+size_t mm_tags_largest_free(const MemoryManagement* mm) {
+  size_t largest = 0;
+  for (size_t offset = mm->tags_free_head; offset != TAGS_NONE;
+       offset = tags_links(mm, offset)->next) {
+    if (tags_size(mm, offset) > largest) {
+      largest = tags_size(mm, offset);
+    }
+  }
+  return largest;
+}
+
+/**************************************************************************************************
+ * mm_tags_print
+ */
+void mm_tags_print(const MemoryManagement* mm) {
+  printf("Memory Management:\n");
+  int    i        = 0;
+  size_t overhead = 0;
+
+  for (size_t offset = 0; offset < mm->tags_end; offset += tags_size(mm, offset)) {
+    printf("Block: %d, Offset: %zu, ", i, mm->base_offset + offset);
+    if (tags_is_free(mm, offset)) {
+      printf("Free, ");
+    } else {
+      printf("Name: %s, ", name_table_str(&mm->name_table, &tags_header(mm, offset)->name));
+    }
+    printf("Size: %zu\n", tags_size(mm, offset));
+
+    overhead += TAGS_OVERHEAD;
+    i++;
+  }
+
+  printf("Tag overhead: %zu bytes\n", overhead);
+}
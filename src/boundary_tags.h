@@ -0,0 +1,70 @@
+// boundary_tags.h
+
+#ifndef BOUNDARY_TAGS_H
+#define BOUNDARY_TAGS_H
+
+#include <stddef.h>
+
+#include "memory_management.h"
+
+/**
+ * Modo boundary tags (--tags): la metadata de los chunks vive dentro de memory_region, como en
+ * un heap real, y no se crea ningún nodo Block; solo el índice de nombres (tags_names) queda
+ * afuera.
+ *
+ *  chunk = [ header | payload | footer ]
+ *   - header: TagHeader { tag = size | libre, BlockName name }            (24 bytes)
+ *   - footer: copia de tag al final del chunk, para leer al vecino izquierdo (8 bytes)
+ *   - payload de un chunk libre: offsets next / prev de la lista de libres (16 bytes)
+ *
+ *  size cuenta el chunk completo (tags incluidos) y es múltiplo de TAGS_ALIGN, así el bit
+ *  bajo de tag queda libre para marcar “libre”. Los vecinos se encuentran por aritmética de
+ *  direcciones: el derecho en offset + size y el izquierdo leyendo el footer en offset - 8.
+ *
+ *  Ubicación sobre la lista de libres (LIFO): FIRST toma el primer chunk de la lista que
+ *  alcanza, BEST el más chico, WORST el más grande y NEXT sigue desde tags_rover. BUDDY y TLSF
+ *  necesitan sus propios índices y no están disponibles en este modo.
+ */
+
+#define TAGS_ALIGN 8
+#define TAGS_NONE  ((size_t) -1)  // offset nulo en la lista de libres
+
+/**
+ * mm_tags_init:
+ *  - Escribe un único chunk libre que ocupa memory_region (truncada a múltiplo de TAGS_ALIGN).
+ */
+int mm_tags_init(MemoryManagement* mm);
+
+/**
+ * mm_tags_alloc / mm_tags_realloc / mm_tags_free:
+ *  - Misma semántica que mm_alloc / mm_realloc / mm_free (incluidas la “fuga” de REALLOC y
+ *    --realloc=move), pero sobre chunks en banda. FREE y REALLOC encuentran el chunk de menor
+ *    offset con ese nombre en tags_names (ver tags_index.h), fuera de la región como NameIndex
+ *    en el modo normal; el coalescing de FREE es O(1).
+ *  - mm_tags_alloc sin lugar: con no_room == NULL imprime el error; si no, deja *no_room en true
+ *    sin imprimir.
+ */
+int mm_tags_alloc(MemoryManagement* mm, const BlockName* name, size_t size, bool* no_room);
+int mm_tags_realloc(MemoryManagement* mm, const BlockName* name, size_t size);
+int mm_tags_free(MemoryManagement* mm, const BlockName* name);
+
+/**
+ * mm_tags_contains:
+ *  - Indica si hay un chunk ocupado con ese nombre.
+ */
+bool mm_tags_contains(const MemoryManagement* mm, const BlockName* name);
+
+/**
+ * mm_tags_largest_free:
+ *  - Tamaño del mayor chunk libre (chunk completo), recorriendo solo la lista de libres.
+ */
+size_t mm_tags_largest_free(const MemoryManagement* mm);
+
+/**
+ * mm_tags_print:
+ *  - Mismo formato que mm_print (offset y size del chunk completo) más una línea final con los
+ *    bytes que ocupan los tags, que se cuentan como espacio usado.
+ */
+void mm_tags_print(const MemoryManagement* mm);
+
+#endif  // BOUNDARY_TAGS_H
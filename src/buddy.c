@@ -0,0 +1,291 @@
+#include "buddy.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "purge.h"
+#include "segment.h"
+
+/**************************************************************************************************
+ * buddy_order
+ *
+ *  Orden k del bloque buddy para 'size' bytes: el menor k >= BUDDY_MIN_ORDER con 2^k >= size.
+ */
+static size_t buddy_order(size_t size) {
+  size_t order = BUDDY_MIN_ORDER;
+  if (size > ((size_t) 1 << BUDDY_MIN_ORDER)) {
+    order = 64 - (size_t) __builtin_clzll((unsigned long long) (size - 1));
+  }
+  return order;
+}
+
+/**************************************************************************************************
+ * buddy_link_after
+ *
+ *  Crea un nodo libre de 'size' bytes justo después de 'block' en la lista por dirección y lo
+ *  agrega a los índices de libres. Devuelve EXIT_FAILURE si el pool no entrega el nodo.
+ */
+static int buddy_link_after(MemoryManagement* mm, Block* block, size_t size) {
+  Block* new_block = block_pool_acquire(&mm->pool);
+  if (new_block == NULL) {
+    fprintf(stderr, "buddy_link_after: No se pudo reservar memoria para nuevo bloque.\n");
+    return EXIT_FAILURE;
+  }
+
+  new_block->free      = true;
+  block_name_clear(&new_block->name);
+  new_block->size      = size;
+  new_block->requested = 0;
+  new_block->offset    = block->offset + block->size - size;
+  new_block->prev      = block;
+  new_block->next      = block->next;
+
+  if (block->next != NULL) {
+    block->next->prev = new_block;
+  }
+  block->next  = new_block;
+  block->size -= size;
+
+  // Partir un libre: la mitad hereda sus páginas sucias; achicar un ocupado: eran bytes ocupados.
+  if (block->free) {
+    mm_purge_inherit(new_block, &block->dirty);
+  } else {
+    new_block->dirty.since = 0;
+    mm_purge_touch(mm, new_block, new_block->offset, new_block->offset + size);
+  }
+
+  mm_index_insert(mm, new_block);
+  return EXIT_SUCCESS;
+}
+
+/**************************************************************************************************
+ * buddy_unlink_next
+ *
+ *  Absorbe block->next (que debe estar fuera de los índices) dentro de 'block' y devuelve su
+ *  nodo al pool, corrigiendo el cursor de next-fit si apuntaba a él.
+ */
+static void buddy_unlink_next(MemoryManagement* mm, Block* block) {
+  Block* next = block->next;
+
+  mm_purge_absorb(block, next);
+  block->size += next->size;
+  block->next  = next->next;
+  if (next->next != NULL) {
+    next->next->prev = block;
+  }
+  if (mm->rover == next) {
+    mm->rover = block;
+  }
+  block_pool_release(&mm->pool, next);
+}
+
+/**************************************************************************************************
+ * buddy_fill
+ *
+ *  Rellena los bytes pedidos del bloque con la primera letra de su nombre.
+ */
+static void buddy_fill(MemoryManagement* mm, Block* block) {
+  memset(
+    (char*)mm->memory_region + block->offset,
+    name_table_str(&mm->name_table, &block->name)[0],
+    block->requested
+  );
+}
+
+/**************************************************************************************************
+ * mm_buddy_init
+ */
+int mm_buddy_init(MemoryManagement* mm) {
+  return mm_buddy_carve(mm, mm->start_block);
+}
+
+/**************************************************************************************************
+ * mm_buddy_carve
+ *
+ *  En cada paso toma el mayor 2^k que entra en lo que queda y al que el offset actual está
+ *  alineado. Para 1 MB (potencia de dos) el bloque inicial queda intacto.
+ */
+int mm_buddy_carve(MemoryManagement* mm, Block* block) {
+  mm_index_remove(mm, block);
+
+  while (block->size > 0) {
+    size_t order = (size_t) free_lists_class(block->size);
+    if (block->offset != 0 && (size_t) __builtin_ctzll(block->offset) < order) {
+      order = (size_t) __builtin_ctzll(block->offset);
+    }
+
+    size_t piece = (size_t) 1 << order;
+    if (piece == block->size || order < BUDDY_MIN_ORDER) {
+      break;
+    }
+
+    if (buddy_link_after(mm, block, block->size - piece) != EXIT_SUCCESS) {
+      mm_index_insert(mm, block);
+      return EXIT_FAILURE;
+    }
+    // buddy_link_after ya indexó el resto; lo sacamos para seguir partiéndolo:
+    mm_index_insert(mm, block);
+    block = block->next;
+    mm_index_remove(mm, block);
+  }
+
+  mm_index_insert(mm, block);
+  return EXIT_SUCCESS;
+}
+
+/**************************************************************************************************
+ * mm_buddy_alloc
+ *
+ *  free_lists_first_from devuelve un bloque del menor orden >= k disponible (las clases de
+ *  free_lists coinciden con los órdenes porque todos los tamaños son potencias de dos). Cada
+ *  división deja libre la mitad derecha, que es el buddy de la izquierda.
+ */
+int mm_buddy_alloc(MemoryManagement* mm, const BlockName* name, size_t size, bool* no_room) {
+  size_t order        = buddy_order(size);
+  Block* block_to_use = free_lists_first_from(&mm->free_lists, order);
+  mm->searches++;
+  mm->search_steps++;  // un solo ctz sobre el bitmap de órdenes
+  while (block_to_use == NULL && order < FREE_LISTS_CLASSES &&
+         mm_grow(mm, (size_t) 1 << order) == EXIT_SUCCESS) {
+    block_to_use = free_lists_first_from(&mm->free_lists, order);
+  }
+  if (block_to_use == NULL) {
+    if (no_room != NULL) {
+      *no_room = true;
+      return EXIT_FAILURE;
+    }
+    fprintf(stderr,
+            "mm_buddy_alloc: No se encontró bloque suficiente (se solicitó %zu bytes) para %s.\n",
+            size, name_table_str(&mm->name_table, name));
+    return EXIT_FAILURE;
+  }
+
+  // 1) Sale de los índices y se divide a la mitad hasta llegar a 2^order:
+  mm_index_remove(mm, block_to_use);
+  while (block_to_use->size > ((size_t) 1 << order)) {
+    if (buddy_link_after(mm, block_to_use, block_to_use->size / 2) != EXIT_SUCCESS) {
+      mm_index_insert(mm, block_to_use);
+      return EXIT_FAILURE;
+    }
+    mm->stats.splits++;
+  }
+
+  // 2) Nombre e índice de nombres:
+  block_to_use->name = *name;
+  if (name_index_insert(&mm->names, block_to_use) != EXIT_SUCCESS) {
+    block_name_clear(&block_to_use->name);
+    mm_index_insert(mm, block_to_use);
+    return EXIT_FAILURE;
+  }
+
+  // 3) Marca como ocupado y contabiliza el redondeo:
+  block_to_use->free      = false;
+  block_to_use->requested = size;
+  mm->internal_fragmentation += block_to_use->size - size;
+  mm->last_alloc              = block_to_use;
+  atomic_store_explicit(&block_to_use->state, BLOCK_LIVE, memory_order_release);
+
+  buddy_fill(mm, block_to_use);
+  return EXIT_SUCCESS;
+}
+
+/**************************************************************************************************
+ * mm_buddy_free
+ *
+ *  El buddy de un bloque de 2^k bytes es el vecino derecho si (offset & 2^k) == 0 y el izquierdo
+ *  si no. Solo se fusiona si el buddy está libre y entero (mismo tamaño y offset offset ^ 2^k);
+ *  si está dividido, alguna de sus mitades sigue ocupada. Un buddy que empieza o termina en el
+ *  borde de un segmento (--grow) es de otro mapeo y tampoco se fusiona.
+ */
+void mm_buddy_free(MemoryManagement* mm, Block* block_to_use) {
+  mm->internal_fragmentation -= block_to_use->size - block_to_use->requested;
+  block_to_use->free      = true;
+  block_to_use->requested = 0;
+
+  Block* block = block_to_use;
+  for (;;) {
+    size_t size  = block->size;
+    Block* buddy = (block->offset & size) ? block->prev : block->next;
+    if (buddy == NULL || !buddy->free || buddy->size != size ||
+        buddy->offset != (block->offset ^ size) ||
+        mm_segment_start(mm, buddy->offset > block->offset ? buddy->offset : block->offset)) {
+      break;
+    }
+
+    mm_index_remove(mm, buddy);
+    if (buddy->offset < block->offset) {
+      block = buddy;
+    }
+    buddy_unlink_next(mm, block);
+    mm->stats.merges++;
+  }
+
+  mm_index_insert(mm, block);
+  mm_purge_freed(mm, block);
+}
+
+/**************************************************************************************************
+ * mm_buddy_realloc
+ *
+ *  Crecer en sitio de 2^j a 2^k requiere que el bloque sea la mitad izquierda en cada nivel
+ *  j..k-1 y que el buddy derecho de cada nivel esté libre y entero; se verifica todo antes de
+ *  tocar la lista para no dejar un estado intermedio.
+ */
+int mm_buddy_realloc(MemoryManagement* mm, Block* block_to_use, size_t size) {
+  size_t order = buddy_order(size);
+  if (order >= FREE_LISTS_CLASSES) {
+    fprintf(stderr, "mm_buddy_realloc: No hay bloque buddy de %zu bytes.\n", size);
+    return EXIT_FAILURE;
+  }
+  size_t target = (size_t) 1 << order;
+  // El aporte viejo a la fragmentación interna se toma antes de que las fusiones o los splits
+  // cambien block_to_use->size.
+  size_t old_waste = block_to_use->size - block_to_use->requested;
+
+  if (target > block_to_use->size) {
+    size_t level = block_to_use->size;
+    Block* next  = block_to_use->next;
+    while (level < target) {
+      if ((block_to_use->offset & level) != 0 || next == NULL || !next->free ||
+          next->size != level || next->offset != block_to_use->offset + level ||
+          mm_segment_start(mm, next->offset)) {
+        // No puede crecer en sitio: se muda (--realloc=move) o “simulamos fuga” igual que
+        // mm_realloc.
+        if (mm->options.realloc_move) {
+          return mm_realloc_move(mm, block_to_use, size);
+        }
+        BlockName block_name = block_to_use->name;
+        if (mm_buddy_alloc(mm, &block_name, size, NULL) != EXIT_SUCCESS) {
+          return EXIT_FAILURE;
+        }
+        mm->stats.leaks++;
+        mm->stats.leaked_bytes += block_to_use->size;
+        return EXIT_SUCCESS;
+      }
+      next   = next->next;
+      level *= 2;
+    }
+
+    while (block_to_use->size < target) {
+      mm_index_remove(mm, block_to_use->next);
+      buddy_unlink_next(mm, block_to_use);
+      mm->stats.merges++;
+    }
+  }
+
+  // Achicar: cada mitad derecha devuelta queda libre junto a su buddy ocupado, sin fusiones.
+  while (block_to_use->size > target) {
+    if (buddy_link_after(mm, block_to_use, block_to_use->size / 2) != EXIT_SUCCESS) {
+      break;
+    }
+    mm->stats.splits++;
+  }
+
+  mm->internal_fragmentation -= old_waste;
+  block_to_use->requested     = size;
+  mm->internal_fragmentation += block_to_use->size - size;
+
+  buddy_fill(mm, block_to_use);
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,59 @@
+// buddy.h
+
+#ifndef BUDDY_H
+#define BUDDY_H
+
+#include <stddef.h>
+
+#include "memory_management.h"
+
+#define BUDDY_MIN_ORDER 4  // bloque mínimo de 2^4 = 16 bytes
+
+/**
+ * Motor de ubicación “buddy” (STRATEGY_BUDDY) sobre la misma lista de Block:
+ *  - Todo bloque (libre u ocupado) mide 2^k bytes y está alineado a 2^k dentro de memory_region.
+ *  - Las listas por orden son las mismas free_lists (para un bloque de 2^k bytes la clase es k).
+ *  - El buddy de un bloque de 2^k bytes en 'offset' está en offset ^ 2^k; como es contiguo,
+ *    siempre es block->next o block->prev y se encuentra en O(1).
+ *  - block->requested guarda lo pedido; block->size - block->requested es fragmentación interna.
+ */
+
+/**
+ * mm_buddy_init:
+ *  - Parte el bloque libre inicial en bloques de potencias de dos alineadas (uno solo si
+ *    total_size es potencia de dos). Un resto menor a 2^BUDDY_MIN_ORDER queda libre pero sin uso.
+ */
+int mm_buddy_init(MemoryManagement* mm);
+
+/**
+ * mm_buddy_carve:
+ *  - Lo mismo para un bloque libre cualquiera (ya en los índices), como el de un segmento nuevo
+ *    de mm_grow. El offset de cada pedazo es relativo a memory_region, así que la alineación
+ *    vale también para los segmentos que agrega --grow.
+ */
+int mm_buddy_carve(MemoryManagement* mm, Block* block);
+
+/**
+ * mm_buddy_alloc:
+ *  - Redondea size a la potencia de dos siguiente, toma un bloque libre del menor orden
+ *    disponible y lo divide a la mitad hasta llegar a ese orden. O(log N).
+ *  - Sin lugar: con no_room == NULL imprime el error; si no, deja *no_room en true sin imprimir.
+ */
+int mm_buddy_alloc(MemoryManagement* mm, const BlockName* name, size_t size, bool* no_room);
+
+/**
+ * mm_buddy_free:
+ *  - Libera block_to_use (ya fuera del índice de nombres) y lo fusiona con su buddy mientras el
+ *    buddy esté libre y entero. O(log N).
+ */
+void mm_buddy_free(MemoryManagement* mm, Block* block_to_use);
+
+/**
+ * mm_buddy_realloc:
+ *  - Achica devolviendo mitades derechas, o crece en sitio absorbiendo buddies derechos libres.
+ *    Si no puede crecer en sitio, simula la fuga igual que mm_realloc: asigna otro bloque con el
+ *    mismo nombre y deja el viejo ocupado.
+ */
+int mm_buddy_realloc(MemoryManagement* mm, Block* block_to_use, size_t size);
+
+#endif  // BUDDY_H
@@ -5,18 +5,26 @@
 
 #include <stddef.h>
 
+#include "name_view.h"
+
+#define COMMAND_MAX_THREADS 1024  // thread_id válidos: 0 .. COMMAND_MAX_THREADS - 1
+
 typedef enum {
   //
   CMD_ALLOC,
   CMD_REALLOC,
   CMD_FREE,
-  CMD_PRINT
+  CMD_PRINT,
+  CMD_STATS,
+  CMD_COMPACT,
+  CMD_PURGE
 } CommandType;
 
 typedef struct {
   CommandType type;
-  char* name;
-  size_t size;
+  NameView name;      // apunta al texto de la línea; vacío sin nombre (ver command_has_name)
+  size_t size;        // bytes de ALLOC/REALLOC; presupuesto de COMPACT (0 = sin límite)
+  unsigned thread_id;  // prefijo opcional "T<n>" de la línea; 0 si no tiene
 } Command;
 
 #endif  // COMMAND_H
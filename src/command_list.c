@@ -0,0 +1,75 @@
+#include "command_list.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "parser.h"
+
+#define COMMAND_LIST_INITIAL_CAPACITY 256
+
+/**************************************************************************************************
+ * command_list_push
+ *
+ *  Agrega un comando al final, duplicando el arreglo cuando se llena.
+ */
+static int command_list_push(CommandList* list, const Command* command) {
+  if (list->count == list->capacity) {
+    size_t   capacity = list->capacity == 0 ? COMMAND_LIST_INITIAL_CAPACITY : list->capacity * 2;
+    Command* commands = realloc(list->commands, capacity * sizeof(Command));
+    if (commands == NULL) {
+      fprintf(stderr, "command_list_push: No se pudo ampliar la lista de comandos.\n");
+      return EXIT_FAILURE;
+    }
+    list->commands = commands;
+    list->capacity = capacity;
+  }
+
+  list->commands[list->count++] = *command;
+  return EXIT_SUCCESS;
+}
+
+/**************************************************************************************************
+ * command_list_load
+ */
+int command_list_load(CommandList* list, const char* filename) {
+  list->commands = NULL;
+  list->count    = 0;
+  list->capacity = 0;
+  list->names    = NULL;
+
+  if (reader_open(&list->reader, filename) != EXIT_SUCCESS) {
+    fprintf(stderr, "command_list_load: No se pudo abrir el archivo: %s\n", filename);
+    return EXIT_FAILURE;
+  }
+
+  const char* line;
+  size_t      length;
+  while (reader_next_line(&list->reader, &line, &length)) {
+    Command command;
+    if (parse_command(line, length, &command) != EXIT_SUCCESS) {
+      fprintf(stderr, "command_list_load: Error al parsear comando: %.*s\n", (int) length, line);
+      command_list_destroy(list);
+      return EXIT_FAILURE;
+    }
+
+    if (command_list_push(list, &command) != EXIT_SUCCESS) {
+      command_list_destroy(list);
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
+
+/**************************************************************************************************
+ * command_list_destroy
+ */
+void command_list_destroy(CommandList* list) {
+  free(list->commands);
+  free(list->names);
+  reader_close(&list->reader);
+  list->commands = NULL;
+  list->names    = NULL;
+  list->count    = 0;
+  list->capacity = 0;
+}
@@ -0,0 +1,45 @@
+// command_list.h
+
+#ifndef COMMAND_LIST_H
+#define COMMAND_LIST_H
+
+#include <stddef.h>
+
+#include "command.h"
+#include "reader.h"
+
+/**
+ * Traza completa en memoria, en el orden del archivo:
+ *  - commands: arreglo dinámico de comandos ya parseados
+ *  - count / capacity: comandos cargados / lugar reservado
+ *  - reader: el archivo mapeado; los name de commands apuntan dentro de él, así que la lista lo
+ *    mantiene abierto hasta command_list_destroy
+ *  - names: con una traza binaria, su tabla de nombres decodificada, adonde apuntan los name en
+ *    lugar del archivo (ver binary_trace_load); NULL si no
+ *
+ * Sirve para las repeticiones que no pueden leer el archivo línea a línea mientras ejecutan
+ * (por ejemplo, repartir los comandos entre hilos).
+ */
+typedef struct {
+  Command* commands;
+  size_t   count;
+  size_t   capacity;
+  Reader   reader;
+  char*    names;
+} CommandList;
+
+/**
+ * command_list_load:
+ *  - Lee y parsea todo 'filename' con las mismas reglas que mm_start (se saltean líneas vacías y
+ *    comentarios). Devuelve EXIT_FAILURE, sin dejar nada reservado, si no puede abrirlo, una
+ *    línea no parsea o no hay memoria.
+ */
+int command_list_load(CommandList* list, const char* filename);
+
+/**
+ * command_list_destroy:
+ *  - Libera el arreglo, el mapeo del archivo y la tabla de nombres (con ellos, los nombres).
+ */
+void command_list_destroy(CommandList* list);
+
+#endif  // COMMAND_LIST_H
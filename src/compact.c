@@ -0,0 +1,204 @@
+#include "compact.h"
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "purge.h"
+
+/**************************************************************************************************
+ * compact_hole
+ *
+ *  Saltea el prefijo ya compacto del segmento [start, end) (ocupados contiguos desde 'start') y
+ *  devuelve el nodo libre que empieza en el primer hueco, fuera de los índices. 'prev' es el
+ *  último nodo antes del segmento (NULL en el primero). Si el hueco es un remanente perdido y no
+ *  un bloque libre, crea un nodo de tamaño 0 para él. Devuelve NULL si no hay hueco (o si el pool
+ *  no entrega el nodo, con *failed = true).
+ */
+static Block* compact_hole(MemoryManagement* mm, Block* prev, size_t start, size_t end,
+                           bool* failed) {
+  Block* block  = prev != NULL ? prev->next : mm->start_block;
+  size_t cursor = start;
+  while (block != NULL && block->offset < end && !block->free && block->offset == cursor) {
+    cursor += block->size;
+    prev    = block;
+    block   = block->next;
+  }
+
+  *failed = false;
+  if (block != NULL && block->offset < end && block->free) {
+    mm_index_remove(mm, block);
+    return block;
+  }
+  if ((block == NULL || block->offset >= end) && cursor == end) {
+    return NULL;  // ya está compacto
+  }
+
+  Block* hole = block_pool_acquire(&mm->pool);
+  if (hole == NULL) {
+    fprintf(stderr, "mm_compact: No se pudo reservar memoria para nuevo bloque.\n");
+    *failed = true;
+    return NULL;
+  }
+  hole->free      = true;
+  block_name_clear(&hole->name);
+  hole->size      = 0;
+  hole->requested = 0;
+  hole->offset    = cursor;
+  hole->prev      = prev;
+  hole->next      = block;
+  if (prev != NULL) {
+    prev->next = hole;
+  } else {
+    mm->start_block = hole;
+  }
+  if (block != NULL) {
+    block->prev = hole;
+  }
+  hole->dirty.since = 0;  // sin bytes propios: lo sucio llega con lo que absorbe o copia
+  return hole;
+}
+
+/**************************************************************************************************
+ * compact_segment
+ *
+ *  El hueco avanza por la lista: un libre que le sigue se absorbe y un ocupado se copia al
+ *  principio del hueco (memmove, porque pueden solaparse) y pasa delante de él. Al final el hueco
+ *  se extiende hasta el bloque siguiente (o hasta el fin del segmento): así recupera también los
+ *  remanentes perdidos que había en el camino. *compacted queda en true si había hueco y
+ *  *stopped si se agotó el presupuesto.
+ */
+static int compact_segment(MemoryManagement* mm, Block* prev, size_t start, size_t end,
+                           size_t budget, size_t* moved, size_t* blocks, bool* compacted,
+                           bool* stopped) {
+  bool   failed;
+  Block* hole = compact_hole(mm, prev, start, end, &failed);
+  if (hole == NULL) {
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+  }
+
+  size_t absorbed = hole->size;  // bytes que ya eran libres (el resto eran remanentes perdidos)
+  size_t touched  = 0;           // fin del último bloque copiado: hasta ahí el hueco está sucio
+  for (Block* next = hole->next; next != NULL && next->offset < end; next = hole->next) {
+    if (next->free) {
+      mm_index_remove(mm, next);
+      absorbed  += next->size;
+      mm_purge_absorb(hole, next);
+      hole->next = next->next;
+      if (next->next != NULL) {
+        next->next->prev = hole;
+      }
+      if (mm->rover == next) {
+        mm->rover = hole;
+      }
+      block_pool_release(&mm->pool, next);
+      mm->stats.merges++;
+      continue;
+    }
+
+    // Al menos un bloque por llamada: si no, uno más grande que el presupuesto frenaría para
+    // siempre a las llamadas siguientes.
+    if (budget != 0 && *moved > 0 && *moved + next->size > budget) {
+      *stopped = true;
+      break;
+    }
+
+    // next pasa delante del hueco, al principio del hueco:
+    memmove((char*) mm->memory_region + hole->offset, (char*) mm->memory_region + next->offset,
+            next->size);
+    touched       = next->offset + next->size;
+    next->offset  = hole->offset;
+    hole->offset += next->size;
+    *moved       += next->size;
+    (*blocks)++;
+
+    Block* before = hole->prev;
+    Block* after  = next->next;
+    next->prev    = before;
+    next->next    = hole;
+    hole->prev    = next;
+    hole->next    = after;
+    if (before != NULL) {
+      before->next = next;
+    } else {
+      mm->start_block = next;
+    }
+    if (after != NULL) {
+      after->prev = hole;
+    }
+  }
+
+  bool inside = hole->next != NULL && hole->next->offset < end;
+  hole->size  = (inside ? hole->next->offset : end) - hole->offset;
+
+  // Lo que excede a 'absorbed' eran remanentes perdidos que vuelven a ser libres:
+  mm->stats.lost_bytes -= hole->size - absorbed;
+  mm->stats.live_bytes += hole->size - absorbed;
+  *compacted            = true;
+
+  // Nunca queda vacío: el hueco existía y mover bloques solo lo corre hacia adelante.
+  mm_purge_touch(mm, hole, hole->offset, touched);
+  mm_index_insert(mm, hole);
+  mm_purge_freed(mm, hole);
+  return EXIT_SUCCESS;
+}
+
+/**************************************************************************************************
+ * mm_compact
+ *
+ *  Compacta cada segmento por separado (uno solo sin --grow), en orden y con un único
+ *  presupuesto: ningún bloque se mueve a otro segmento.
+ */
+int mm_compact(MemoryManagement* mm, size_t budget, size_t* moved, size_t* blocks) {
+  *moved  = 0;
+  *blocks = 0;
+  if (mm->options.tags || mm->strategy == STRATEGY_BUDDY) {
+    fprintf(stderr, "mm_compact: COMPACT no está disponible con buddy ni con --tags.\n");
+    return EXIT_FAILURE;
+  }
+  mm_cache_flush(mm);  // los bloques de --cache también son espacio a juntar
+
+  bool   compacted = false;
+  bool   stopped   = false;
+  Block* prev      = NULL;  // último nodo antes del segmento
+  for (size_t i = 0; i < mm->segment_count && !stopped; i++) {
+    size_t start = mm->segment_starts[i];
+    size_t end   = i + 1 < mm->segment_count ? mm->segment_starts[i + 1] : mm->total_size;
+    for (Block* next = prev != NULL ? prev->next : mm->start_block;
+         next != NULL && next->offset < start; next = next->next) {
+      prev = next;
+    }
+
+    if (compact_segment(mm, prev, start, end, budget, moved, blocks, &compacted, &stopped) !=
+        EXIT_SUCCESS) {
+      return EXIT_FAILURE;
+    }
+  }
+
+  if (compacted) {
+    mm->stats.compactions++;
+  }
+  mm->stats.compacted_bytes += *moved;
+  return EXIT_SUCCESS;
+}
+
+/**************************************************************************************************
+ * mm_compact_print
+ */
+int mm_compact_print(MemoryManagement* mm, size_t budget) {
+  size_t          moved, blocks;
+  struct timespec start, end;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  int result = mm_compact(mm, budget, &moved, &blocks);
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  if (result != EXIT_SUCCESS) {
+    return EXIT_FAILURE;
+  }
+
+  double ms = (double) (end.tv_sec - start.tv_sec) * 1e3 +
+              (double) (end.tv_nsec - start.tv_nsec) / 1e6;
+  printf("Compact: %zu bytes moved in %zu blocks, %.3f ms\n", moved, blocks, ms);
+  return EXIT_SUCCESS;
+}
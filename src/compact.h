@@ -0,0 +1,41 @@
+// compact.h
+
+#ifndef COMPACT_H
+#define COMPACT_H
+
+#include <stddef.h>
+
+#include "memory_management.h"
+
+/**
+ * Compactación (COMPACT y --compact-retry) sobre la lista de Block:
+ *  - Los bloques ocupados se deslizan hacia el offset 0 con memmove, en orden: la lista por
+ *    dirección y las cadenas del índice de nombres quedan ordenadas igual que antes.
+ *  - Todo el espacio que se libera (bloques libres y remanentes perdidos, ver stats.h) termina
+ *    en un único bloque libre detrás del último bloque movido.
+ *  - Antes se vacía la caché de --cache (mm_cache_flush).
+ *  - Con --grow cada segmento se compacta por separado: su espacio libre queda al final de él.
+ *  - No está disponible con BUDDY (rompería la alineación de los buddies) ni con --tags.
+ */
+
+/**
+ * mm_compact:
+ *  - budget: máximo de bytes a mover; 0 = sin límite (compactación completa). Un bloque que no
+ *    entra en lo que queda del presupuesto no se mueve y la pasada termina ahí, así que cada
+ *    llamada acota la pausa; llamadas sucesivas continúan desde el primer hueco. El primer
+ *    bloque de cada llamada se mueve siempre, aunque supere el presupuesto, para que la
+ *    compactación avance.
+ *  - *moved / *blocks: bytes y bloques movidos en esta llamada.
+ *  - Los nodos libres absorbidos vuelven al pool; si el rover de next-fit apuntaba a uno, pasa
+ *    al bloque libre resultante.
+ */
+int mm_compact(MemoryManagement* mm, size_t budget, size_t* moved, size_t* blocks);
+
+/**
+ * mm_compact_print:
+ *  - Comando COMPACT [K]: mm_compact con presupuesto K e imprime bytes y bloques movidos y el
+ *    tiempo que llevó.
+ */
+int mm_compact_print(MemoryManagement* mm, size_t budget);
+
+#endif  // COMPACT_H
@@ -0,0 +1,161 @@
+#include "compare.h"
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "binary_trace.h"
+#include "compact.h"
+#include "memory_management.h"
+#include "parser.h"
+#include "purge.h"
+
+/**
+ * Trabajo de un hilo de compare_start: repite 'list' entera con una estrategia.
+ */
+typedef struct {
+  const CommandList* list;
+  size_t             size;
+  const MMOptions*   options;
+  CompareResult      result;
+  pthread_t          handle;
+  bool               started;
+} CompareWorker;
+
+/**************************************************************************************************
+ * compare_seconds
+ */
+static double compare_seconds(const struct timespec* start, const struct timespec* end) {
+  return (double) (end->tv_sec - start->tv_sec) + (double) (end->tv_nsec - start->tv_nsec) / 1e9;
+}
+
+/**************************************************************************************************
+ * compare_measure
+ *
+ *  Todo sale de mm->stats (ver stats.h): no hace falta recorrer la lista de bloques.
+ */
+static void compare_measure(const MemoryManagement* mm, CompareResult* result) {
+  result->free_bytes   = mm->stats.free_bytes;
+  result->largest_free = mm_largest_free(mm);
+  result->leaked_bytes = mm->stats.leaked_bytes + mm->stats.lost_bytes;
+
+  if (result->free_bytes > 0) {
+    result->fragmentation = 1.0 - (double) result->largest_free / (double) result->free_bytes;
+  }
+}
+
+/**************************************************************************************************
+ * compare_worker_run
+ */
+static void* compare_worker_run(void* arg) {
+  CompareWorker* worker = arg;
+  CompareResult* result = &worker->result;
+
+  MemoryManagement mm;
+  if (mm_init(&mm, result->strategy, worker->size, worker->options) != EXIT_SUCCESS) {
+    fprintf(stderr, "compare_start: No se pudo inicializar MemoryManagement (%s).\n",
+            strategy_name(result->strategy));
+    result->result = EXIT_FAILURE;
+    return NULL;
+  }
+
+  struct timespec start, end;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for (size_t i = 0; i < worker->list->count; i++) {
+    const Command* command = &worker->list->commands[i];
+    if (command->type == CMD_PRINT || command->type == CMD_STATS) {
+      continue;  // seis listados intercalados no le sirven a nadie
+    }
+    if (command->type == CMD_COMPACT || command->type == CMD_PURGE) {
+      size_t moved, blocks;  // sin los reportes de COMPACT y PURGE, por lo mismo
+      int    done = command->type == CMD_COMPACT ? mm_compact(&mm, command->size, &moved, &blocks)
+                                                 : mm_purge(&mm, &moved);
+      if (done == EXIT_SUCCESS) {
+        result->succeeded++;
+      } else {
+        result->failed++;
+      }
+      continue;
+    }
+    if (mm_execute_command(&mm, command) == EXIT_SUCCESS) {
+      result->succeeded++;
+    } else {
+      result->failed++;
+    }
+  }
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  result->seconds = compare_seconds(&start, &end);
+
+  compare_measure(&mm, result);
+  mm_destroy(&mm);
+  result->result = EXIT_SUCCESS;
+  return NULL;
+}
+
+/**************************************************************************************************
+ * compare_print
+ */
+static void compare_print(const CompareWorker* workers, double seconds) {
+  printf("%-8s %12s %12s %14s %14s %14s %12s\n", "Strategy", "Succeeded", "Failed",
+         "Fragmentation", "Largest free", "Leaked bytes", "Time (ms)");
+  for (size_t i = 0; i < STRATEGY_COUNT; i++) {
+    const CompareResult* result = &workers[i].result;
+    if (result->result != EXIT_SUCCESS) {
+      printf("%-8s %12s\n", strategy_name(result->strategy), "error");
+      continue;
+    }
+    printf("%-8s %12zu %12zu %13.2f%% %14zu %14zu %12.3f\n", strategy_name(result->strategy),
+           result->succeeded, result->failed, result->fragmentation * 100.0, result->largest_free,
+           result->leaked_bytes, result->seconds * 1e3);
+  }
+  printf("Wall time: %.3f ms\n", seconds * 1e3);
+}
+
+/**************************************************************************************************
+ * compare_start
+ *
+ *  La traza se parsea una vez antes de lanzar los hilos; cada hilo solo lee list y escribe en su
+ *  propio CompareWorker, así que no hace falta ningún lock.
+ */
+int compare_start(const char* filename, size_t size, const MMOptions* options) {
+  CommandList list;
+  int loaded = binary_trace_probe(filename) ? binary_trace_load(&list, filename)
+                                            : command_list_load(&list, filename);
+  if (loaded != EXIT_SUCCESS) {
+    return EXIT_FAILURE;
+  }
+
+  CompareWorker workers[STRATEGY_COUNT] = {0};
+  struct timespec start, end;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for (size_t i = 0; i < STRATEGY_COUNT; i++) {
+    CompareWorker* worker   = &workers[i];
+    worker->list            = &list;
+    worker->size            = size;
+    worker->options         = options;
+    worker->result.strategy = (StrategyType) i;
+    worker->result.result   = EXIT_FAILURE;
+    worker->started = pthread_create(&worker->handle, NULL, compare_worker_run, worker) == 0;
+    if (!worker->started) {
+      fprintf(stderr, "compare_start: No se pudo crear el hilo de %s.\n",
+              strategy_name(worker->result.strategy));
+    }
+  }
+
+  int result = EXIT_SUCCESS;
+  for (size_t i = 0; i < STRATEGY_COUNT; i++) {
+    if (workers[i].started) {
+      pthread_join(workers[i].handle, NULL);
+    }
+    if (workers[i].result.result != EXIT_SUCCESS) {
+      result = EXIT_FAILURE;
+    }
+  }
+  clock_gettime(CLOCK_MONOTONIC, &end);
+
+  compare_print(workers, compare_seconds(&start, &end));
+  command_list_destroy(&list);
+  return result;
+}
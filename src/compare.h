@@ -0,0 +1,45 @@
+// compare.h
+
+#ifndef COMPARE_H
+#define COMPARE_H
+
+#include <stddef.h>
+
+#include "command_list.h"
+#include "options.h"
+#include "strategy.h"
+
+/**
+ * Resultado de repetir una traza con una estrategia (ver compare_start):
+ *  - succeeded / failed: comandos ALLOC, REALLOC, FREE y COMPACT que funcionaron y que fallaron
+ *  - free_bytes / largest_free: bytes libres al final y el mayor bloque libre
+ *  - fragmentation: fragmentación externa final, 1 - largest_free / free_bytes (0 sin libres)
+ *  - leaked_bytes: bytes que la traza ya no puede liberar: los bloques viejos que dejaron las
+ *    “fugas” de REALLOC más los remanentes de split que no llegaron a ser un bloque
+ *    (stats.leaked_bytes + stats.lost_bytes)
+ *  - seconds: tiempo de pared de la repetición
+ */
+typedef struct {
+  StrategyType strategy;
+  int          result;
+  size_t       succeeded;
+  size_t       failed;
+  size_t       free_bytes;
+  size_t       largest_free;
+  double       fragmentation;
+  size_t       leaked_bytes;
+  double       seconds;
+} CompareResult;
+
+/**
+ * compare_start:
+ *  - Modo "all": carga 'filename' una sola vez (texto o binaria) y la repite en paralelo, un hilo
+ *    por estrategia, cada uno con su propio MemoryManagement de 'size' bytes y las mismas
+ *    'options' (NULL: por defecto). Los comandos y sus nombres se comparten de solo lectura.
+ *  - Un comando que falla se cuenta y la repetición sigue (sus mensajes van a stderr); PRINT y
+ *    STATS se ignoran. Al final imprime una tabla con una fila por estrategia.
+ *  - El tiempo total es el de la estrategia más lenta, no la suma.
+ */
+int compare_start(const char* filename, size_t size, const MMOptions* options);
+
+#endif  // COMPARE_H
@@ -0,0 +1,130 @@
+#include "free_lists.h"
+
+/**************************************************************************************************
+ * free_lists_init
+ *
+ *  Deja todas las listas vacías y el bitmap en cero.
+ */
+void free_lists_init(FreeLists* lists) {
+  for (size_t i = 0; i < FREE_LISTS_CLASSES; i++) {
+    lists->heads[i] = NULL;
+  }
+  lists->bitmap = 0;
+}
+
+/**************************************************************************************************
+ * free_lists_class
+ *
+ *  floor(log2(size)): la posición del bit más significativo encendido.
+ */
+size_t free_lists_class(size_t size) {
+  if (size == 0) {
+    return 0;
+  }
+  return (size_t) (63 - __builtin_clzll((unsigned long long) size));
+}
+
+/**************************************************************************************************
+ * free_lists_classes_above
+ *
+ *  Máscara con las clases no vacías estrictamente mayores que 'size_class'.
+ */
+static uint64_t free_lists_classes_above(const FreeLists* lists, size_t size_class) {
+  if (size_class + 1 >= FREE_LISTS_CLASSES) {
+    return 0;
+  }
+  return lists->bitmap & (~UINT64_C(0) << (size_class + 1));
+}
+
+/**************************************************************************************************
+ * free_lists_insert
+ *
+ *  Inserta el bloque al inicio de la lista de su clase y enciende el bit correspondiente.
+ */
+void free_lists_insert(FreeLists* lists, Block* block) {
+  size_t size_class = free_lists_class(block->size);
+  Block* head       = lists->heads[size_class];
+
+  block->prev_free = NULL;
+  block->next_free = head;
+  if (head != NULL) {
+    head->prev_free = block;
+  }
+
+  lists->heads[size_class] = block;
+  lists->bitmap |= UINT64_C(1) << size_class;
+}
+
+/**************************************************************************************************
+ * free_lists_remove
+ *
+ *  Desenlaza el bloque de la lista de su clase. Si la lista queda vacía, apaga su bit.
+ */
+void free_lists_remove(FreeLists* lists, Block* block) {
+  size_t size_class = free_lists_class(block->size);
+
+  if (block->prev_free != NULL) {
+    block->prev_free->next_free = block->next_free;
+  } else {
+    lists->heads[size_class] = block->next_free;
+  }
+  if (block->next_free != NULL) {
+    block->next_free->prev_free = block->prev_free;
+  }
+
+  block->next_free = NULL;
+  block->prev_free = NULL;
+
+  if (lists->heads[size_class] == NULL) {
+    lists->bitmap &= ~(UINT64_C(1) << size_class);
+  }
+}
+
+/**************************************************************************************************
+ * free_lists_first_from
+ */
+Block* free_lists_first_from(const FreeLists* lists, size_t min_class) {
+  if (min_class >= FREE_LISTS_CLASSES) {
+    return NULL;
+  }
+
+  uint64_t classes = lists->bitmap & (~UINT64_C(0) << min_class);
+  if (classes == 0) {
+    return NULL;
+  }
+  return lists->heads[__builtin_ctzll(classes)];
+}
+
+/**************************************************************************************************
+ * free_lists_first_fit
+ *
+ *  La clase de requested_size puede tener bloques más chicos que lo pedido, así que ahí se filtra
+ *  por tamaño; cualquier bloque de una clase mayor alcanza. Entre todos los candidatos se
+ *  devuelve el de offset mínimo, que es el que encontraría el recorrido por dirección.
+ */
+Block* free_lists_first_fit(const FreeLists* lists, size_t requested_size, size_t* steps) {
+  size_t size_class = free_lists_class(requested_size);
+  Block* first      = NULL;
+
+  for (Block* current = lists->heads[size_class]; current != NULL; current = current->next_free) {
+    ++*steps;
+    if (current->size >= requested_size && (first == NULL || current->offset < first->offset)) {
+      first = current;
+    }
+  }
+
+  uint64_t classes = free_lists_classes_above(lists, size_class);
+  while (classes != 0) {
+    size_t k = (size_t) __builtin_ctzll(classes);
+    classes &= classes - 1;
+
+    for (Block* current = lists->heads[k]; current != NULL; current = current->next_free) {
+      ++*steps;
+      if (first == NULL || current->offset < first->offset) {
+        first = current;
+      }
+    }
+  }
+
+  return first;
+}
@@ -0,0 +1,59 @@
+// free_lists.h
+
+#ifndef FREE_LISTS_H
+#define FREE_LISTS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "block.h"
+
+#define FREE_LISTS_CLASSES 64  // una clase por potencia de dos de un size_t
+
+/**
+ * Índice de bloques libres segregado por clase de tamaño:
+ *  - heads[k]: lista (doblemente enlazada vía next_free / prev_free) de los bloques libres
+ *              con 2^k <= size < 2^(k+1). Dentro de una lista no hay orden particular.
+ *  - bitmap:   bit k encendido ⇔ heads[k] != NULL, para saltar clases vacías.
+ */
+typedef struct {
+  Block*   heads[FREE_LISTS_CLASSES];
+  uint64_t bitmap;
+} FreeLists;
+
+/**
+ * free_lists_init:
+ *  - Deja todas las clases vacías.
+ */
+void free_lists_init(FreeLists* lists);
+
+/**
+ * free_lists_class:
+ *  - Devuelve la clase de tamaño de 'size', es decir floor(log2(size)) (0 para size == 0).
+ */
+size_t free_lists_class(size_t size);
+
+/**
+ * free_lists_insert / free_lists_remove:
+ *  - Agregan o quitan un bloque libre de la lista de su clase. El tamaño del bloque no debe
+ *    cambiar mientras esté en el índice.
+ */
+void free_lists_insert(FreeLists* lists, Block* block);
+void free_lists_remove(FreeLists* lists, Block* block);
+
+/**
+ * free_lists_first_from:
+ *  - Devuelve la cabeza de la clase no vacía más baja que sea >= min_class (O(1) con el bitmap),
+ *    o NULL si no hay ninguna.
+ */
+Block* free_lists_first_from(const FreeLists* lists, size_t min_class);
+
+/**
+ * free_lists_first_fit:
+ *  - Devuelve el bloque con size >= requested_size y offset mínimo, el mismo que encontraría el
+ *    recorrido lineal de la lista por dirección. Solo recorre las clases que pueden satisfacer
+ *    requested_size. Suma a *steps los bloques examinados.
+ */
+Block* free_lists_first_fit(const FreeLists* lists, size_t requested_size, size_t* steps);
+
+#endif  // FREE_LISTS_H
@@ -0,0 +1,197 @@
+#include "free_tree.h"
+
+/**************************************************************************************************
+ * Funciones auxiliares del AVL
+ *
+ *  Las operaciones son recursivas (la profundidad es O(log n)) y devuelven la nueva raíz del
+ *  subárbol, ya rebalanceada.
+ */
+static int free_tree_compare(const Block* a, const Block* b) {
+  if (a->size != b->size) {
+    return a->size < b->size ? -1 : 1;
+  }
+  if (a->offset != b->offset) {
+    return a->offset < b->offset ? -1 : 1;
+  }
+  return 0;
+}
+
+static int free_tree_height(const Block* node) {
+  return node != NULL ? node->tree_height : 0;
+}
+
+static void free_tree_update(Block* node) {
+  int left  = free_tree_height(node->tree_left);
+  int right = free_tree_height(node->tree_right);
+  node->tree_height = (left > right ? left : right) + 1;
+}
+
+static Block* free_tree_rotate_right(Block* node) {
+  Block* left      = node->tree_left;
+  node->tree_left  = left->tree_right;
+  left->tree_right = node;
+  free_tree_update(node);
+  free_tree_update(left);
+  return left;
+}
+
+static Block* free_tree_rotate_left(Block* node) {
+  Block* right      = node->tree_right;
+  node->tree_right  = right->tree_left;
+  right->tree_left  = node;
+  free_tree_update(node);
+  free_tree_update(right);
+  return right;
+}
+
+static Block* free_tree_rebalance(Block* node) {
+  free_tree_update(node);
+  int balance = free_tree_height(node->tree_left) - free_tree_height(node->tree_right);
+
+  if (balance > 1) {
+    if (free_tree_height(node->tree_left->tree_left) <
+        free_tree_height(node->tree_left->tree_right)) {
+      node->tree_left = free_tree_rotate_left(node->tree_left);
+    }
+    return free_tree_rotate_right(node);
+  }
+
+  if (balance < -1) {
+    if (free_tree_height(node->tree_right->tree_right) <
+        free_tree_height(node->tree_right->tree_left)) {
+      node->tree_right = free_tree_rotate_right(node->tree_right);
+    }
+    return free_tree_rotate_left(node);
+  }
+
+  return node;
+}
+
+static Block* free_tree_insert_node(Block* root, Block* block) {
+  if (root == NULL) {
+    return block;
+  }
+  if (free_tree_compare(block, root) < 0) {
+    root->tree_left = free_tree_insert_node(root->tree_left, block);
+  } else {
+    root->tree_right = free_tree_insert_node(root->tree_right, block);
+  }
+  return free_tree_rebalance(root);
+}
+
+static Block* free_tree_remove_min(Block* root, Block** min) {
+  if (root->tree_left == NULL) {
+    *min = root;
+    return root->tree_right;
+  }
+  root->tree_left = free_tree_remove_min(root->tree_left, min);
+  return free_tree_rebalance(root);
+}
+
+static Block* free_tree_remove_node(Block* root, const Block* block) {
+  if (root == NULL) {
+    return NULL;
+  }
+
+  int cmp = free_tree_compare(block, root);
+  if (cmp < 0) {
+    root->tree_left = free_tree_remove_node(root->tree_left, block);
+    return free_tree_rebalance(root);
+  }
+  if (cmp > 0) {
+    root->tree_right = free_tree_remove_node(root->tree_right, block);
+    return free_tree_rebalance(root);
+  }
+
+  // Encontrado: lo reemplaza su sucesor (el mínimo del subárbol derecho).
+  Block* left  = root->tree_left;
+  Block* right = root->tree_right;
+  if (right == NULL) {
+    return left;
+  }
+
+  Block* successor;
+  right                 = free_tree_remove_min(right, &successor);
+  successor->tree_left  = left;
+  successor->tree_right = right;
+  return free_tree_rebalance(successor);
+}
+
+/**************************************************************************************************
+ * free_tree_init
+ */
+void free_tree_init(FreeTree* tree) {
+  tree->root  = NULL;
+  tree->count = 0;
+}
+
+/**************************************************************************************************
+ * free_tree_insert
+ *
+ *  Inserta el bloque como hoja y rebalancea el camino hasta la raíz.
+ */
+void free_tree_insert(FreeTree* tree, Block* block) {
+  block->tree_left   = NULL;
+  block->tree_right  = NULL;
+  block->tree_height = 1;
+
+  tree->root = free_tree_insert_node(tree->root, block);
+  tree->count++;
+}
+
+/**************************************************************************************************
+ * free_tree_remove
+ *
+ *  Localiza el bloque por su clave (size, offset) y lo desenlaza.
+ */
+void free_tree_remove(FreeTree* tree, Block* block) {
+  tree->root = free_tree_remove_node(tree->root, block);
+  tree->count--;
+
+  block->tree_left   = NULL;
+  block->tree_right  = NULL;
+  block->tree_height = 0;
+}
+
+/**************************************************************************************************
+ * free_tree_lower_bound
+ *
+ *  Desciende guardando el último nodo con size >= requested_size; al ir siempre a la izquierda
+ *  cuando el nodo alcanza, termina en el menor (size, offset) que alcanza.
+ */
+Block* free_tree_lower_bound(const FreeTree* tree, size_t requested_size, size_t* steps) {
+  Block* current = tree->root;
+  Block* best    = NULL;
+
+  while (current != NULL) {
+    ++*steps;
+    if (current->size >= requested_size) {
+      best    = current;
+      current = current->tree_left;
+    } else {
+      current = current->tree_right;
+    }
+  }
+
+  return best;
+}
+
+/**************************************************************************************************
+ * free_tree_max
+ *
+ *  El nodo más a la derecha tiene el size máximo pero, entre empates, el offset máximo.
+ *  Para respetar el desempate por offset mínimo se busca el lower bound de ese size.
+ */
+Block* free_tree_max(const FreeTree* tree, size_t* steps) {
+  Block* current = tree->root;
+  if (current == NULL) {
+    return NULL;
+  }
+
+  while (current->tree_right != NULL) {
+    ++*steps;
+    current = current->tree_right;
+  }
+
+  return free_tree_lower_bound(tree, current->size, steps);
+}
@@ -0,0 +1,51 @@
+// free_tree.h
+
+#ifndef FREE_TREE_H
+#define FREE_TREE_H
+
+#include <stddef.h>
+
+#include "block.h"
+
+/**
+ * Árbol AVL intrusivo de bloques libres ordenado por la clave (size, offset):
+ *  - root: raíz del árbol (NULL si no hay bloques libres)
+ *  - count: cantidad de bloques en el árbol
+ *
+ * Como el offset es único entre bloques libres, la clave identifica al bloque. La clave no debe
+ * cambiar mientras el bloque esté en el árbol: hay que sacarlo, modificarlo y volver a insertarlo.
+ */
+typedef struct {
+  Block* root;
+  size_t count;
+} FreeTree;
+
+/**
+ * free_tree_init:
+ *  - Deja el árbol vacío.
+ */
+void free_tree_init(FreeTree* tree);
+
+/**
+ * free_tree_insert / free_tree_remove:
+ *  - Insertan o quitan un bloque libre en O(log n).
+ */
+void free_tree_insert(FreeTree* tree, Block* block);
+void free_tree_remove(FreeTree* tree, Block* block);
+
+/**
+ * free_tree_lower_bound:
+ *  - Devuelve el bloque con menor (size, offset) tal que size >= requested_size,
+ *    es decir, el best-fit (a igual size, el de menor offset). NULL si no hay.
+ *  - Suma a *steps los nodos visitados (la altura del descenso).
+ */
+Block* free_tree_lower_bound(const FreeTree* tree, size_t requested_size, size_t* steps);
+
+/**
+ * free_tree_max:
+ *  - Devuelve el bloque de mayor size; a igual size, el de menor offset (el worst-fit).
+ *    NULL si el árbol está vacío. Suma a *steps los nodos visitados.
+ */
+Block* free_tree_max(const FreeTree* tree, size_t* steps);
+
+#endif  // FREE_TREE_H
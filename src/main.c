@@ -1,30 +1,90 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
+#include "arena.h"
+#include "binary_trace.h"
+#include "command_list.h"
+#include "compare.h"
 #include "memory_management.h"
 #include "parser.h"
+#include "pipeline.h"
 
-#define MEMORY_SIZE (1024 * 1024)  // 1 MB
+#define MEMORY_SIZE (1024 * 1024)  // 1 MB, salvo --size
 
 int main(int argc, char** argv) {
-  if (argc != 3) {
-    fprintf(stderr, "Usage: %s <file> <best|first|worst>.\n", argv[0]);
+  if (argc < 3) {
+    fprintf(stderr,
+            "Usage: %s <file> <best|first|worst|next|buddy|tlsf|all> [--tags] [--arenas=N] "
+            "[--pipeline] [--compact-retry] [--realloc=move|leak] [--size=BYTES[K|M|G|T]] "
+            "[--hugepages] [--grow[=MAX]] [--cache[=N]] "
+            "[--coalesce=eager|lazy[:N]] [--purge=eager[:MIN]|decay:N[:MIN]].\n",
+            argv[0]);
     return EXIT_FAILURE;
   }
 
+  MMOptions options = {0};
+  for (int i = 3; i < argc; i++) {
+    if (parse_option(argv[i], &options) != EXIT_SUCCESS) {
+      return EXIT_FAILURE;
+    }
+  }
+  size_t size = options.region_size != 0 ? options.region_size : MEMORY_SIZE;
+
+  // "all": todas las estrategias en paralelo sobre la misma traza, con una tabla comparativa:
+  if (strcmp(argv[2], "all") == 0) {
+    if (options.tags || options.arenas > 0 || options.pipeline) {
+      fprintf(stderr, "Error: all no admite --tags, --arenas ni --pipeline.\n");
+      return EXIT_FAILURE;
+    }
+    return compare_start(argv[1], size, &options);
+  }
+
   StrategyType strategy;
   if (parse_strategy(argv[2], &strategy) != EXIT_SUCCESS) {
     fprintf(stderr, "Unknown strategy: %s\n", argv[2]);
     return EXIT_FAILURE;
   }
 
+  // Con arenas, la traza se carga entera y cada prefijo T<n> corre en su propio hilo:
+  if (options.arenas > 0) {
+    CommandList list;
+    int loaded = binary_trace_probe(argv[1]) ? binary_trace_load(&list, argv[1])
+                                             : command_list_load(&list, argv[1]);
+    if (loaded != EXIT_SUCCESS) {
+      return EXIT_FAILURE;
+    }
+
+    ArenaSet set;
+    if (arena_set_init(&set, strategy, size, options.arenas, &options) != EXIT_SUCCESS) {
+      fprintf(stderr, "Error: no se pudieron inicializar las arenas.\n");
+      command_list_destroy(&list);
+      return EXIT_FAILURE;
+    }
+
+    int result = arena_replay(&set, &list);
+    arena_set_destroy(&set);
+    command_list_destroy(&list);
+    return result;
+  }
+
   MemoryManagement mm;
-  if (mm_init(&mm, strategy, MEMORY_SIZE) != EXIT_SUCCESS) {
+  if (mm_init(&mm, strategy, size, &options) != EXIT_SUCCESS) {
     fprintf(stderr, "Error: no se pudo inicializar MemoryManagement.\n");
     return EXIT_FAILURE;
   }
 
-  if (mm_start(&mm, argv[1]) != EXIT_SUCCESS) {
+  // Una traza binaria (ver binary_trace.h) se reconoce por su magic y se repite sin tokenizar;
+  // una de texto se puede parsear en un hilo aparte (--pipeline):
+  int result;
+  if (binary_trace_probe(argv[1])) {
+    result = binary_trace_start(&mm, argv[1]);
+  } else if (options.pipeline) {
+    result = pipeline_start(&mm, argv[1]);
+  } else {
+    result = mm_start(&mm, argv[1]);
+  }
+  if (result != EXIT_SUCCESS) {
     mm_destroy(&mm);
     return EXIT_FAILURE;
   }
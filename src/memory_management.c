@@ -4,64 +4,232 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "boundary_tags.h"
+#include "buddy.h"
+#include "compact.h"
 #include "command.h"
 #include "parser.h"
+#include "purge.h"
+#include "reader.h"
+#include "region.h"
+#include "segment.h"
 
+/**************************************************************************************************
+ * mm_stats_lose
+ *
+ *  Un remanente de 'bytes' que no llega a ser un Block sale de la lista: ni ocupado ni libre.
+ */
+static void mm_stats_lose(MemoryManagement* mm, size_t bytes) {
+  mm->stats.lost_bytes += bytes;
+  mm->stats.live_bytes -= bytes;
+}
+
+/**************************************************************************************************
+ * mm_index_insert / mm_index_remove
+ *
+ *  Mantienen los índices de bloques libres (free_lists por clase y free_tree por tamaño).
+ *  Todo bloque libre de la lista está en ambos; el tamaño de un bloque solo puede cambiar
+ *  mientras está fuera de los índices. Con TLSF el único índice es tlsf, así cada operación
+ *  queda en O(1).
+ */
+void mm_index_insert(MemoryManagement* mm, Block* block) {
+  mm->stats.free_bytes += block->size;
+  mm->stats.free_blocks++;
+  mm->stats.live_bytes -= block->size;
+  if (mm->strategy == STRATEGY_TLSF) {
+    tlsf_index_insert(&mm->tlsf, block);
+    return;
+  }
+  free_lists_insert(&mm->free_lists, block);
+  free_tree_insert(&mm->free_tree, block);
+}
+
+void mm_index_remove(MemoryManagement* mm, Block* block) {
+  mm->stats.free_bytes -= block->size;
+  mm->stats.free_blocks--;
+  mm->stats.live_bytes += block->size;
+  if (mm->strategy == STRATEGY_TLSF) {
+    tlsf_index_remove(&mm->tlsf, block);
+    return;
+  }
+  free_lists_remove(&mm->free_lists, block);
+  free_tree_remove(&mm->free_tree, block);
+}
 
 /**************************************************************************************************
  * mm_init
  *
- *  Inicializa la estructura MemoryManagement. Reserva un bloque grande de 'size' bytes con malloc,
- *  y crea el primer Block, marcándolo como libre (free = true), offset = 0, size = size total.
+ *  Inicializa la estructura MemoryManagement. Reserva un bloque grande de 'size' bytes con mmap
+ *  (region_map, con páginas grandes si options->hugepages) y crea el primer Block, marcándolo
+ *  como libre (free = true), offset = 0, size = size total.
  *
  *  Parámetros:
  *    - mm: puntero a MemoryManagement (no debe ser NULL)
- *    - strategy: algoritmo de asignación (FIRST, BEST, WORST)
+ *    - strategy: algoritmo de asignación (FIRST, BEST, WORST, NEXT, BUDDY o TLSF)
  *    - size: tamaño total (en bytes) que pedimos al SO
+ *    - options: opciones extra (NULL = valores por defecto). Con tags, la metadata va en banda
+ *      y no se crea el primer Block.
  *
  *  Retorna:
  *    - EXIT_SUCCESS si todo salió bien
- *    - EXIT_FAILURE si malloc de memory_region falla o no se pudo crear el primer Block
+ *    - EXIT_FAILURE si el mmap de memory_region falla o no se pudo crear el primer Block
  */
-int mm_init(MemoryManagement* mm, StrategyType strategy, size_t size) {
+int mm_init(MemoryManagement* mm, StrategyType strategy, size_t size, const MMOptions* options) {
   if (mm == NULL) {
     fprintf(stderr, "mm_init: puntero mm NULL.\n");
     return EXIT_FAILURE;
   }
 
-  mm->strategy = strategy;
-  mm->total_size = size;
+  // 1) Pedimos el bloque de tamaño 'size' al SO (mmap: las páginas se asignan al tocarlas); con
+  //    --grow se reserva de una vez el tope, para que los segmentos queden contiguos:
+  bool   hugepages = options != NULL && options->hugepages;
+  size_t capacity  = size;
+  if (options != NULL && options->grow) {
+    size_t limit = options->grow_limit != 0 ? options->grow_limit : SEGMENT_DEFAULT_LIMIT;
+    capacity     = region_page_round(limit > size ? limit : size);
+  }
+  void* region = capacity != 0 ? region_map(capacity, hugepages) : NULL;
+  if (region == NULL) {
+    fprintf(stderr, "mm_init: No se pudo reservar %zu bytes.\n", capacity);
+    return EXIT_FAILURE;
+  }
+
+  // 2) El resto es igual que sobre una región ajena, salvo que esta la libera mm_destroy:
+  if (mm_init_region(mm, strategy, region, size, 0, options) != EXIT_SUCCESS) {
+    region_unmap(region, capacity, hugepages);
+    return EXIT_FAILURE;
+  }
+  mm->owns_region     = true;
+  mm->region_capacity = capacity;
+
+  // 3) Lo reservado detrás de 'size' queda inaccesible hasta que mm_grow lo use (si mprotect
+  //    falla, por ejemplo con páginas de MAP_HUGETLB, la reserva queda abierta):
+  size_t mapped = region_page_round(size);
+  if (capacity > mapped) {
+    mm->segment_guard =
+      region_protect((char*) region + mapped, capacity - mapped, false) == EXIT_SUCCESS;
+  }
+  return EXIT_SUCCESS;
+}
+
+/**************************************************************************************************
+ * mm_init_region
+ *
+ *  Como mm_init pero sobre 'size' bytes que ya existen (por ejemplo, el tramo de una arena dentro
+ *  de una región compartida). base_offset es la posición de 'region' dentro de esa región
+ *  compartida; solo se usa para que PRINT muestre offsets globales.
+ */
+int mm_init_region(MemoryManagement* mm, StrategyType strategy, void* region, size_t size,
+                   size_t base_offset, const MMOptions* options) {
+  mm->strategy      = strategy;
+  mm->total_size    = size;
+  mm->memory_region = region;
+  mm->owns_region   = false;
+  mm->base_offset   = base_offset;
+  memset(&mm->options, 0, sizeof(MMOptions));
+  if (options != NULL) {
+    mm->options = *options;
+  }
+
+  if (mm->options.tags && (strategy == STRATEGY_BUDDY || strategy == STRATEGY_TLSF)) {
+    fprintf(stderr, "mm_init: La estrategia elegida no está disponible con --tags.\n");
+    return EXIT_FAILURE;
+  }
+  if (mm->options.tags && mm->options.purge != PURGE_NONE) {
+    fprintf(stderr, "mm_init: --purge no está disponible con --tags.\n");
+    return EXIT_FAILURE;
+  }
+  if (mm->options.tags && mm->options.grow) {
+    fprintf(stderr, "mm_init: --grow no está disponible con --tags.\n");
+    return EXIT_FAILURE;
+  }
+  if (mm->options.purge_threshold == 0) {
+    mm->options.purge_threshold = PURGE_DEFAULT_MIN;
+  }
+  // La caché trabaja sobre nodos Block de tamaño exacto: buddy redondea y --tags no tiene nodos.
+  // Por lo mismo, buddy (que solo une buddies) y --tags siempre unen en el FREE.
+  if (strategy == STRATEGY_BUDDY || mm->options.tags) {
+    mm->options.cache    = false;
+    mm->options.coalesce = COALESCE_EAGER;
+  }
+  if (mm->options.cache_count == 0) {
+    mm->options.cache_count = BLOCK_CACHE_DEFAULT_COUNT;
+  }
 
-  // 1) Pedimos el bloque de tamaño 'size' al SO:
-  mm->memory_region = malloc(size);
-  if (mm->memory_region == NULL) {
-    fprintf(stderr, "mm_init: No se pudo reservar %zu bytes.\n", size);
+  // Índice de nombres y tabla de nombres internados vacíos:
+  block_pool_init(&mm->pool);
+  if (name_index_init(&mm->names) != EXIT_SUCCESS) {
     return EXIT_FAILURE;
   }
+  if (name_table_init(&mm->name_table) != EXIT_SUCCESS) {
+    name_index_destroy(&mm->names);
+    return EXIT_FAILURE;
+  }
+
+  mm->start_block = NULL;
+  mm->rover       = NULL;
+  mm->last_alloc  = NULL;
+  mm->searches     = 0;
+  mm->search_steps = 0;
+  mm->purge_clock  = 1;
+  mm->lazy_frees   = 0;
+  mm->region_capacity   = size;
+  mm->segment_count     = 1;
+  mm->segment_starts[0] = 0;
+  mm->segment_guard     = false;
+  memset(&mm->stats, 0, sizeof(MMStats));
+  mm->stats.live_bytes = size;  // hasta que el bloque inicial entre a los índices de libres
+  mm->internal_fragmentation = 0;
+  free_lists_init(&mm->free_lists);
+  free_tree_init(&mm->free_tree);
+  tlsf_index_init(&mm->tlsf);
+  block_cache_init(&mm->cache);
+
+  // Con boundary tags toda la metadata queda dentro de memory_region:
+  if (mm->options.tags) {
+    if (mm_tags_init(mm) != EXIT_SUCCESS) {
+      mm_destroy(mm);
+      return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+  }
 
-  // 2) Creamos el nodo inicial que representa TODO el bloque libre:
-  Block* initial = (Block*) malloc(sizeof(Block));
+  // Creamos el nodo inicial que representa TODO el bloque libre (desde el pool de nodos):
+  Block* initial = block_pool_acquire(&mm->pool);
   if (initial == NULL) {
     fprintf(stderr, "mm_init: No se pudo reservar memoria para el primer Block.\n");
-    free(mm->memory_region);
+    mm_destroy(mm);
     return EXIT_FAILURE;
   }
 
   initial->free   = true;
-  initial->name   = NULL;
+  block_name_clear(&initial->name);
   initial->size   = size;
+  initial->requested = 0;
   initial->offset = 0;      // empieza en el primer byte de memory_region
+  initial->dirty.since = 0;  // páginas recién mapeadas, nunca tocadas
   initial->next   = NULL;
   initial->prev   = NULL;
 
   mm->start_block = initial;
+  mm->rover       = initial;
+
+  // Los índices de libres arrancan con ese único bloque:
+  mm_index_insert(mm, initial);
+
+  // El motor buddy necesita bloques de potencias de dos desde el principio:
+  if (strategy == STRATEGY_BUDDY && mm_buddy_init(mm) != EXIT_SUCCESS) {
+    mm_destroy(mm);
+    return EXIT_FAILURE;
+  }
   return EXIT_SUCCESS;
 }
 
 /**************************************************************************************************
  * mm_destroy
  *
- *  Libera todos los bloques de metadata (lista enlazada) y libera el bloque grande (memory_region).
+ *  Libera los slabs del pool de nodos (toda la metadata de una vez), las tablas de nombres
+ *  y el bloque grande (memory_region).
  *
  *  Parámetros:
  *    - mm: puntero a MemoryManagement; si es NULL, sale sin hacer nada.
@@ -71,85 +239,106 @@ void mm_destroy(MemoryManagement* mm) {
     return;
   }
 
-  // 1) Recorrer la lista y liberar cada Block:
-  Block* current = mm->start_block;
-  while (current != NULL) {
-    Block* next = current->next;
-    if (current->name != NULL) {
-      free(current->name);
-    }
-    free(current);
-    current = next;
-  }
+  // 1) Los nodos (con sus nombres inline) se liberan junto con el pool:
+  block_pool_destroy(&mm->pool);
 
-  // 2) Liberar la región de datos:
-  free(mm->memory_region);
+  // 2) Liberar la región de datos (si es nuestra) y las tablas de nombres:
+  if (mm->owns_region) {
+    region_unmap(mm->memory_region, mm->region_capacity, mm->options.hugepages);
+  }
+  name_index_destroy(&mm->names);
+  name_table_destroy(&mm->name_table);
+  if (mm->options.tags) {
+    tags_index_destroy(&mm->tags_names);
+  }
   mm->memory_region = NULL;
   mm->start_block   = NULL;
+  mm->rover         = NULL;
+  free_lists_init(&mm->free_lists);
+  free_tree_init(&mm->free_tree);
+  block_cache_init(&mm->cache);
 }
 
 /**************************************************************************************************
  * mm_find_block_first_fit
  *
- *  Recorre la lista desde el inicio y devuelve el PRIMER bloque libre con size >= requested_size.
+ *  Devuelve el bloque libre de menor offset con size >= requested_size, consultando solo las
+ *  clases de free_lists que pueden satisfacer el pedido.
  *  Si no encuentra, devuelve NULL.
  */
 Block* mm_find_block_first_fit(MemoryManagement* mm, size_t requested_size) {
-  Block* current = mm->start_block;
-  while (current != NULL) {
-    if (current->free && current->size >= requested_size) {
-      return current;
-    }
-    current = current->next;
-  }
-  // No se encontró bloque suficiente
-  return NULL;
+  return free_lists_first_fit(&mm->free_lists, requested_size, &mm->search_steps);
 }
 
 /**************************************************************************************************
  * mm_find_block_best_fit
  *
- *  Recorre toda la lista y guarda el bloque libre con (size >= requested_size) 
- *  y con el size **mínimo** posible (entre los que cumplen).
+ *  Devuelve el bloque libre con (size >= requested_size) y con el size **mínimo** posible
+ *  (entre los que cumplen); a igual size, el de menor offset. Es el lower bound de
+ *  (requested_size, 0) en free_tree: O(log n).
  *  Si no hay ninguno, devuelve NULL.
  */
 Block* mm_find_block_best_fit(MemoryManagement* mm, size_t requested_size) {
-  Block* current = mm->start_block;
-  Block* best    = NULL;
-
-  while (current != NULL) {
-    if (current->free && current->size >= requested_size) {
-      if (best == NULL || current->size < best->size) {
-        best = current;
-      }
-    }
-    current = current->next;
-  }
-
-  return best;
+  return free_tree_lower_bound(&mm->free_tree, requested_size, &mm->search_steps);
 }
 
 /**************************************************************************************************
  * mm_find_block_worst_fit
  *
- *  Recorre la lista y guarda el bloque libre con (size >= requested_size) 
- *  y con el size **máximo** posible (entre los que cumplen).
+ *  Devuelve el bloque libre con (size >= requested_size) y con el size **máximo** posible
+ *  (entre los que cumplen); a igual size, el de menor offset. Es el máximo de free_tree:
+ *  si ni ese alcanza, ninguno alcanza. O(log n).
  *  Si no hay ninguno, devuelve NULL.
  */
 Block* mm_find_block_worst_fit(MemoryManagement* mm, size_t requested_size) {
-  Block* current     = mm->start_block;
-  Block* worst_fit   = NULL;
+  Block* worst_fit = free_tree_max(&mm->free_tree, &mm->search_steps);
+  if (worst_fit == NULL || worst_fit->size < requested_size) {
+    return NULL;
+  }
+  return worst_fit;
+}
+
+/**************************************************************************************************
+ * mm_find_block_next_fit
+ *
+ *  Recorre la lista desde mm->rover hasta el final y luego desde el inicio hasta mm->rover
+ *  (una sola vuelta), devolviendo el primer bloque libre con size >= requested_size.
+ *  El rover queda en el bloque encontrado, de modo que la próxima búsqueda continúa desde ahí
+ *  en lugar de volver a recorrer los fragmentos del principio.
+ *  Si no encuentra, devuelve NULL y el rover no se mueve.
+ */
+Block* mm_find_block_next_fit(MemoryManagement* mm, size_t requested_size) {
+  Block* start   = mm->rover != NULL ? mm->rover : mm->start_block;
+  Block* current = start;
 
   while (current != NULL) {
+    mm->search_steps++;
     if (current->free && current->size >= requested_size) {
-      if (worst_fit == NULL || current->size > worst_fit->size) {
-        worst_fit = current;
-      }
+      mm->rover = current;
+      return current;
     }
     current = current->next;
+    if (current == NULL) {
+      current = mm->start_block;
+    }
+    if (current == start) {
+      break;
+    }
   }
 
-  return worst_fit;
+  // No se encontró bloque suficiente en toda la vuelta
+  return NULL;
+}
+
+/**************************************************************************************************
+ * mm_find_block_tlsf
+ *
+ *  Devuelve un bloque libre con size >= requested_size tomado de la primera lista TLSF no vacía
+ *  desde la subclase redondeada de requested_size: O(1), sin recorrer bloques. No es first-fit
+ *  ni best-fit exacto; a cambio el peor caso está acotado.
+ */
+Block* mm_find_block_tlsf(MemoryManagement* mm, size_t requested_size) {
+  return tlsf_index_find(&mm->tlsf, requested_size, &mm->search_steps);
 }
 
 /**************************************************************************************************
@@ -159,8 +348,12 @@ Block* mm_find_block_worst_fit(MemoryManagement* mm, size_t requested_size) {
  *    - FIRST -> mm_find_block_first_fit
  *    - BEST  -> mm_find_block_best_fit
  *    - WORST -> mm_find_block_worst_fit
+ *    - NEXT  -> mm_find_block_next_fit
+ *    - TLSF  -> mm_find_block_tlsf
+ *  Cada llamada cuenta en mm->searches y los nodos que examina en mm->search_steps.
  */
 Block* mm_find_block(MemoryManagement* mm, size_t requested_size) {
+  mm->searches++;
   switch (mm->strategy) {
     case STRATEGY_FIRST:
       return mm_find_block_first_fit(mm, requested_size);
@@ -168,38 +361,58 @@ Block* mm_find_block(MemoryManagement* mm, size_t requested_size) {
       return mm_find_block_best_fit(mm, requested_size);
     case STRATEGY_WORST:
       return mm_find_block_worst_fit(mm, requested_size);
+    case STRATEGY_NEXT:
+      return mm_find_block_next_fit(mm, requested_size);
+    case STRATEGY_TLSF:
+      return mm_find_block_tlsf(mm, requested_size);
     default:
       fprintf(stderr, "mm_find_block: Estrategia desconocida: %d.\n", mm->strategy);
       return NULL;
   }
 }
 
+/**************************************************************************************************
+ * mm_contains
+ */
+bool mm_contains(const MemoryManagement* mm, NameView name) {
+  BlockName block_name;
+  if (!name_table_find(&mm->name_table, name, &block_name)) {
+    return false;
+  }
+  if (mm->options.tags) {
+    return mm_tags_contains(mm, &block_name);
+  }
+  return name_index_find(&mm->names, &block_name) != NULL;
+}
+
 /**************************************************************************************************
  * mm_alloc_split
  *
  *  Divide el bloque block_to_use en 2 partes si el remanente (block_to_use->size - size) 
- *  es mayor que sizeof(Block), para mantener espacio libre. De lo contrario, reasigna 
- *  block_to_use->size = size y no crea bloque nuevo.
+ *  es mayor que MM_SPLIT_THRESHOLD, para mantener espacio libre. De lo contrario, reasigna 
+ *  block_to_use->size = size y no crea bloque nuevo. El remanente entra a los índices de libres.
  *
  *  Parámetros:
- *    - block_to_use: apuntador a un bloque libre con size >= 'size'
+ *    - mm: estructura completa (para actualizar los índices de libres)
+ *    - block_to_use: apuntador a un bloque libre con size >= 'size', fuera de los índices de libres
  *    - size: tamaño solicitado por mm_alloc (en bytes)
  *
  *  Retorna:
  *    - EXIT_SUCCESS si pudo (o no necesitó dividir)
- *    - EXIT_FAILURE si malloc para el nuevo bloque falla.
+ *    - EXIT_FAILURE si el pool no puede entregar un nodo para el nuevo bloque.
  */
-int mm_alloc_split(Block* block_to_use, size_t size) {
+int mm_alloc_split(MemoryManagement* mm, Block* block_to_use, size_t size) {
   size_t rest_size = block_to_use->size - size;
 
   // Si el remanente es demasiado pequeño para crear un Block (metadata), no dividimos:
-  if (rest_size <= sizeof(Block) || rest_size == 0) {
+  if (rest_size <= MM_SPLIT_THRESHOLD || rest_size == 0) {
     block_to_use->size = size;
+    mm_stats_lose(mm, rest_size);
     return EXIT_SUCCESS;
   }
 
   // Creamos el bloque nuevo para el remanente:
-  Block* new_block = (Block*) malloc(sizeof(Block));
+  Block* new_block = block_pool_acquire(&mm->pool);
   if (new_block == NULL) {
     fprintf(stderr, "mm_alloc_split: No se pudo reservar memoria para nuevo bloque.\n");
     return EXIT_FAILURE;
@@ -207,12 +420,15 @@ int mm_alloc_split(Block* block_to_use, size_t size) {
 
   // Inicializamos el bloque “libre” resultante:
   new_block->free   = true;
-  new_block->name   = NULL;
+  block_name_clear(&new_block->name);
   new_block->size   = rest_size;
+  new_block->requested = 0;
   new_block->offset = block_to_use->offset + size;  // justo después del bloque original
   new_block->prev   = block_to_use;
   new_block->next   = block_to_use->next;
 
+  mm_purge_inherit(new_block, &block_to_use->dirty);  // mismas páginas que el libre partido
+
   // Si había un siguiente, ajustamos su 'prev':
   if (block_to_use->next != NULL) {
     block_to_use->next->prev = new_block;
@@ -222,16 +438,130 @@ int mm_alloc_split(Block* block_to_use, size_t size) {
   block_to_use->size = size;
   block_to_use->next = new_block;
 
+  mm_index_insert(mm, new_block);
+  mm->stats.splits++;
+
   return EXIT_SUCCESS;
 }
 
+/**************************************************************************************************
+ * mm_alloc_place
+ *
+ *  Último paso de mm_alloc_named: block_to_use ya mide 'size' bytes y no está en los índices de
+ *  libres (viene partido de mm_find_block o tal cual de la caché). Si el índice de nombres
+ *  falla, el bloque vuelve a los libres.
+ */
+static int mm_alloc_place(MemoryManagement* mm, Block* block_to_use, const BlockName* name,
+                          size_t size) {
+  // 1) Guardar el nombre (metadata) y registrarlo en el índice de nombres:
+  block_to_use->name = *name;
+  if (name_index_insert(&mm->names, block_to_use) != EXIT_SUCCESS) {
+    block_name_clear(&block_to_use->name);
+    block_to_use->free = true;
+    mm_index_insert(mm, block_to_use);
+    return EXIT_FAILURE;
+  }
+
+  // 2) Marca como ocupado:
+  block_to_use->free      = false;
+  block_to_use->requested = size;
+  mm->last_alloc          = block_to_use;
+  atomic_store_explicit(&block_to_use->state, BLOCK_LIVE, memory_order_release);
+
+  // 3) Rellenar con el primer carácter de 'name'
+  memset(
+    (char*)mm->memory_region + block_to_use->offset,
+    name_table_str(&mm->name_table, name)[0],
+    block_to_use->size
+  );
+
+  return EXIT_SUCCESS;
+}
+
+/**************************************************************************************************
+ * mm_alloc_named
+ *
+ *  Cuerpo de mm_alloc una vez resuelto el BlockName (también lo usa la “fuga” de mm_realloc, que
+ *  ya tiene el nombre del bloque viejo). No hace ninguna reserva en el heap para el nombre.
+ *  Si no hay lugar, con no_room == NULL imprime el error y si no deja *no_room en true.
+ */
+static int mm_alloc_named(MemoryManagement* mm, const BlockName* name, size_t size,
+                          bool* no_room) {
+  if (mm->options.tags) {
+    return mm_tags_alloc(mm, name, size, no_room);
+  }
+  if (mm->strategy == STRATEGY_BUDDY) {
+    return mm_buddy_alloc(mm, name, size, no_room);
+  }
+
+  const char* text = name_table_str(&mm->name_table, name);
+
+  // Con --cache, un bloque liberado del mismo tamaño se reusa tal cual:
+  if (mm->options.cache && block_cache_fits(size)) {
+    Block* cached = block_cache_pop(&mm->cache, size);
+    if (cached != NULL) {
+      mm->stats.cache_hits++;
+      mm->stats.cached_bytes -= size;
+      mm->stats.live_bytes   += size;
+      return mm_alloc_place(mm, cached, name, size);
+    }
+    mm->stats.cache_misses++;
+  }
+
+  Block* block_to_use = mm_find_block(mm, size);
+  if (block_to_use == NULL && mm->cache.blocks > 0) {
+    // Presión de memoria: los bloques guardados en la caché vuelven a los libres, ya unidos.
+    mm_cache_flush(mm);
+    block_to_use = mm_find_block(mm, size);
+  }
+  if (block_to_use == NULL && mm->options.coalesce == COALESCE_LAZY) {
+    // Con --coalesce=lazy puede haber libres contiguos sin unir que juntos alcanzan:
+    mm_coalesce(mm);
+    block_to_use = mm_find_block(mm, size);
+  }
+  if (block_to_use == NULL && mm->options.compact_retry &&
+      mm->stats.free_bytes + mm->stats.lost_bytes >= size) {
+    // El espacio está, pero repartido: se compacta todo y se busca de nuevo.
+    size_t moved, blocks;
+    if (mm_compact(mm, 0, &moved, &blocks) == EXIT_SUCCESS) {
+      block_to_use = mm_find_block(mm, size);
+    }
+  }
+  // Con --grow se agregan segmentos hasta que aparezca el bloque o se llegue al tope:
+  while (block_to_use == NULL && mm_grow(mm, size) == EXIT_SUCCESS) {
+    block_to_use = mm_find_block(mm, size);
+  }
+  if (block_to_use == NULL && no_room != NULL) {
+    *no_room = true;
+    return EXIT_FAILURE;
+  }
+  if (block_to_use == NULL) {
+    fprintf(stderr,
+            "mm_alloc: No se encontró bloque suficiente (se solicitó %zu bytes) para %s.\n",
+            size, text);
+    return EXIT_FAILURE;
+  }
+
+  // 1) Sale de los índices de libres antes de cambiar su tamaño; si es más grande, dividimos:
+  mm_index_remove(mm, block_to_use);
+  if (block_to_use->size > size) {
+    if (mm_alloc_split(mm, block_to_use, size) != EXIT_SUCCESS) {
+      mm_index_insert(mm, block_to_use);
+      return EXIT_FAILURE;
+    }
+  }
+
+  return mm_alloc_place(mm, block_to_use, name, size);
+}
+
 /**************************************************************************************************
  * mm_alloc
  *
  *  1) Busca un bloque libre con size >= size, según strategy.
  *  2) Si no lo encuentra, imprime error y devuelve EXIT_FAILURE.
  *  3) Si el bloque encontrado tiene size > size, llama a mm_alloc_split para crear remanente.
- *  4) Duplica el nombre de la variable y lo asigna a block_to_use->name.
+ *  4) Guarda el nombre en block_to_use->name (inline si es corto, internado en mm->name_table
+ *     si es largo) y lo registra en mm->names.
  *  5) Marca block_to_use->free = false.
  *  6) Rellena la parte de memoria (memory_region + offset) con el primer carácter del nombre.
  *
@@ -244,45 +574,30 @@ int mm_alloc_split(Block* block_to_use, size_t size) {
  *    - EXIT_SUCCESS en caso de éxito
  *    - EXIT_FAILURE en caso de no poder asignar o de error interno
  */
-int mm_alloc(MemoryManagement* mm, const char* name, size_t size) {
-  if (size == 0) {
-    fprintf(stderr, "mm_alloc: Tamaño 0 no válido para %s.\n", name);
-    return EXIT_FAILURE;
-  }
+int mm_alloc(MemoryManagement* mm, NameView name, size_t size) {
+  return mm_try_alloc(mm, name, size, NULL);
+}
 
-  Block* block_to_use = mm_find_block(mm, size);
-  if (block_to_use == NULL) {
-    fprintf(stderr,
-            "mm_alloc: No se encontró bloque suficiente (se solicitó %zu bytes) para %s.\n",
-            size, name);
-    return EXIT_FAILURE;
+/**************************************************************************************************
+ * mm_try_alloc
+ */
+int mm_try_alloc(MemoryManagement* mm, NameView name, size_t size, bool* no_room) {
+  if (no_room != NULL) {
+    *no_room = false;
   }
-
-  // 1) Si el bloque es más grande, dividimos:
-  if (block_to_use->size > size) {
-    if (mm_alloc_split(block_to_use, size) != EXIT_SUCCESS) {
-      return EXIT_FAILURE;
-    }
+  if (size == 0) {
+    fprintf(stderr, "mm_alloc: Tamaño 0 no válido para %.*s.\n", (int) name.length, name.data);
+    return EXIT_FAILURE;
   }
 
-  // 2) Guardar el nombre (metadata):
-  block_to_use->name = strdup(name);
-  if (block_to_use->name == NULL) {
-    fprintf(stderr, "mm_alloc: No se pudo duplicar el nombre: %s.\n", name);
+  BlockName block_name;
+  if (name_table_make(&mm->name_table, name, &block_name) != EXIT_SUCCESS) {
+    fprintf(stderr, "mm_alloc: No se pudo internar el nombre: %.*s.\n", (int) name.length,
+            name.data);
     return EXIT_FAILURE;
   }
 
-  // 3) Marca como ocupado:
-  block_to_use->free = false;
-
-  // 4) Rellenar con el primer carácter de 'name'
-  memset(
-    (char*)mm->memory_region + block_to_use->offset,
-    name[0],
-    block_to_use->size
-  );
-
-  return EXIT_SUCCESS;
+  return mm_alloc_named(mm, &block_name, size, no_room);
 }
 
 /**************************************************************************************************
@@ -294,40 +609,46 @@ int mm_alloc(MemoryManagement* mm, const char* name, size_t size) {
  *  ocupada con el primer carácter de block_to_use->name para “llenar” la nueva zona.
  *
  *  Parámetros:
+ *    - mm: estructura completa (el remanente entra a los índices de libres)
  *    - block_to_use: bloque ocupado que vamos a “achicar”
  *    - size: nuevo tamaño (menor que block_to_use->size)
  *
  *  Retorna:
- *    - EXIT_SUCCESS (aunque malloc para el nuevo bloque falle, igual reducimos size)
- *    - EXIT_FAILURE solo si no se pudo malloc para metadata (pero en este caso igual hacemos shrink)
+ *    - EXIT_SUCCESS (aunque el pool no entregue el nuevo bloque, igual reducimos size)
+ *    - EXIT_FAILURE solo si no se pudo obtener metadata (pero en este caso igual hacemos shrink)
  */
-int mm_realloc_shrink(Block* block_to_use, size_t size) {
+int mm_realloc_shrink(MemoryManagement* mm, Block* block_to_use, size_t size) {
   // Calculamos cuánto espacio sobra si achicamos
   size_t rest_size = block_to_use->size - size;
 
-  // Si el remanente es demasiado pequeño (<= sizeof(Block)) o cero,
+  // Si el remanente es demasiado pequeño (< MM_SPLIT_THRESHOLD) o cero,
   // simplemente ajustamos block_to_use->size a 'size' y listo.
-  if (rest_size < sizeof(Block) || rest_size == 0) {
+  if (rest_size < MM_SPLIT_THRESHOLD || rest_size == 0) {
     block_to_use->size = size;
+    mm_stats_lose(mm, rest_size);
     return EXIT_SUCCESS;
   }
 
   // Creamos un nuevo bloque libre para el remanente
-  Block* new_block = malloc(sizeof(Block));
+  Block* new_block = block_pool_acquire(&mm->pool);
   if (new_block == NULL) {
     fprintf(stderr, "mm_realloc_shrink: No se pudo reservar memoria para nuevo bloque.\n");
-    // Aunque falle malloc, ajustamos de todos modos el tamaño del bloque a 'size'
+    // Aunque falle el pool, ajustamos de todos modos el tamaño del bloque a 'size'
     block_to_use->size = size;
+    mm_stats_lose(mm, rest_size);
     return EXIT_SUCCESS;
   }
 
   // Inicializamos el bloque libre remanente
   new_block->size   = rest_size;
+  new_block->requested = 0;
   new_block->free   = true;
-  new_block->name   = NULL;
+  block_name_clear(&new_block->name);
   new_block->offset = block_to_use->offset + size;
   new_block->next   = block_to_use->next;
   new_block->prev   = block_to_use;
+  new_block->dirty.since = 0;
+  mm_purge_touch(mm, new_block, new_block->offset, new_block->offset + rest_size);  // ocupados
 
   // Ajustamos punteros de la lista doblemente enlazada
   if (block_to_use->next != NULL) {
@@ -338,6 +659,9 @@ int mm_realloc_shrink(Block* block_to_use, size_t size) {
   // Finalmente ajustamos el tamaño del bloque original
   block_to_use->size = size;
 
+  mm_index_insert(mm, new_block);
+  mm->stats.splits++;
+
   // ¡Sin memset aquí! El relleno de la zona ocupada
   // lo hará quien llamó a esta función, es decir, mm_realloc().
 
@@ -366,8 +690,8 @@ int mm_realloc_shrink(Block* block_to_use, size_t size) {
  */
 int mm_realloc_grow(MemoryManagement* mm, Block* block_to_use, size_t size) {
   Block* next_block = block_to_use->next;
-  if (next_block == NULL || !next_block->free) {
-    // No se puede expandir en sitio
+  if (next_block == NULL || !next_block->free || mm_segment_start(mm, next_block->offset)) {
+    // No se puede expandir en sitio (el siguiente, si es de otro segmento, no cuenta)
     return EXIT_FAILURE;
   }
 
@@ -377,22 +701,27 @@ int mm_realloc_grow(MemoryManagement* mm, Block* block_to_use, size_t size) {
     return EXIT_FAILURE;
   }
 
-  // 1) Unir block_to_use con next_block:
+  // 1) Unir block_to_use con next_block (que deja de estar en los índices de libres):
+  BlockDirty dirty = next_block->dirty;  // el remanente son páginas de next_block
+  mm_index_remove(mm, next_block);
   block_to_use->size = combined_size;
   block_to_use->next = next_block->next;
   if (next_block->next != NULL) {
     next_block->next->prev = block_to_use;
   }
-  // Liberamos la metadata del next_block
-  if (next_block->name != NULL) free(next_block->name);
-  free(next_block);
+  // Devolvemos la metadata del next_block al pool (el rover no puede quedar apuntándolo)
+  if (mm->rover == next_block) {
+    mm->rover = block_to_use;
+  }
+  block_pool_release(&mm->pool, next_block);
+  mm->stats.merges++;
 
   // 2) Si la unión es EXACTA (combined_size == size), devolvemos:
   if (combined_size == size) {
     // Rellenar con la primera letra del nombre:
     memset(
       (char*)mm->memory_region + block_to_use->offset,
-      block_to_use->name[0],
+      name_table_str(&mm->name_table, &block_to_use->name)[0],
       block_to_use->size
     );
     return EXIT_SUCCESS;
@@ -404,37 +733,140 @@ int mm_realloc_grow(MemoryManagement* mm, Block* block_to_use, size_t size) {
   size_t rest_size = combined_size - size;
 
   // Crear bloque remanente (igual a mm_realloc_shrink):
-  Block* rest_block = (Block*) malloc(sizeof(Block));
+  Block* rest_block = block_pool_acquire(&mm->pool);
   if (rest_block == NULL) {
-    // Si falla el malloc, al menos dejamos al bloque con el nuevo tamaño:
+    // Si falla el pool, al menos dejamos al bloque con el nuevo tamaño:
     block_to_use->size = size;
+    mm_stats_lose(mm, rest_size);
     // Rellenamos con el nombre
     memset(
       (char*)mm->memory_region + block_to_use->offset,
-      block_to_use->name[0],
+      name_table_str(&mm->name_table, &block_to_use->name)[0],
       block_to_use->size
     );
     return EXIT_SUCCESS;
   }
 
   rest_block->size   = rest_size;
+  rest_block->requested = 0;
   rest_block->free   = true;
-  rest_block->name   = NULL;
+  block_name_clear(&rest_block->name);
   rest_block->offset = block_to_use->offset + size;
   rest_block->next   = block_to_use->next;
   rest_block->prev   = block_to_use;
+  mm_purge_inherit(rest_block, &dirty);
 
   if (block_to_use->next != NULL) {
     block_to_use->next->prev = rest_block;
   }
   block_to_use->next = rest_block;
 
+  mm_index_insert(mm, rest_block);
+  mm->stats.splits++;
+
   // Ajustamos el tamaño final del bloque:
   // (ya lo habíamos puesto a 'size')
   // Rellenamos la parte ocupada con el primer carácter:
   memset(
     (char*)mm->memory_region + block_to_use->offset,
-    block_to_use->name[0],
+    name_table_str(&mm->name_table, &block_to_use->name)[0],
+    block_to_use->size
+  );
+
+  return EXIT_SUCCESS;
+}
+
+/**************************************************************************************************
+ * mm_realloc_relocate
+ *
+ *  Asigna otro bloque con el mismo nombre, copia el contenido del viejo y lo libera. El bloque
+ *  viejo sigue en la lista mientras se busca lugar: si un --compact-retry lo corre, su Block*
+ *  sigue valiendo y se copia desde el offset nuevo.
+ */
+static int mm_realloc_relocate(MemoryManagement* mm, Block* block_to_use, size_t size) {
+  BlockName block_name = block_to_use->name;
+  if (mm_alloc_named(mm, &block_name, size, NULL) != EXIT_SUCCESS) {
+    return EXIT_FAILURE;
+  }
+
+  Block* new_block = mm->last_alloc;
+  memcpy((char*)mm->memory_region + new_block->offset,
+         (char*)mm->memory_region + block_to_use->offset, block_to_use->size);
+  mm->stats.moves++;
+  mm->stats.moved_bytes += block_to_use->size;
+
+  mm_free_block(mm, block_to_use);
+  return EXIT_SUCCESS;
+}
+
+/**************************************************************************************************
+ * mm_realloc_move
+ *
+ *  1) Si el anterior está libre y anterior + bloque (+ siguiente libre) alcanza: ambos vecinos
+ *     salen de los índices, el contenido se mueve al offset del anterior y el nodo del bloque
+ *     (que es el que está en el índice de nombres) se queda con todo; los nodos absorbidos
+ *     vuelven al pool. Lo que sobra lo devuelve mm_realloc_shrink.
+ *  2) Si no, mm_realloc_relocate. Como en mm_free_join, los vecinos de la lista cuentan como
+ *     contiguos aunque entre ellos haya bytes perdidos.
+ */
+int mm_realloc_move(MemoryManagement* mm, Block* block_to_use, size_t size) {
+  Block* prev_block = block_to_use->prev;
+  Block* next_block = block_to_use->next;
+  if (mm->strategy == STRATEGY_BUDDY || prev_block == NULL || !prev_block->free ||
+      mm_segment_start(mm, block_to_use->offset)) {
+    return mm_realloc_relocate(mm, block_to_use, size);
+  }
+
+  size_t combined_size = prev_block->size + block_to_use->size;
+  if (next_block != NULL && next_block->free && !mm_segment_start(mm, next_block->offset)) {
+    combined_size += next_block->size;
+  } else {
+    next_block = NULL;
+  }
+  if (combined_size < size) {
+    return mm_realloc_relocate(mm, block_to_use, size);
+  }
+
+  // 1) El siguiente (si está libre) se une como en mm_realloc_grow:
+  if (next_block != NULL) {
+    mm_index_remove(mm, next_block);
+    block_to_use->next = next_block->next;
+    if (next_block->next != NULL) {
+      next_block->next->prev = block_to_use;
+    }
+    if (mm->rover == next_block) {
+      mm->rover = block_to_use;
+    }
+    block_pool_release(&mm->pool, next_block);
+    mm->stats.merges++;
+  }
+
+  // 2) El contenido baja al comienzo del anterior, que desaparece de la lista:
+  mm_index_remove(mm, prev_block);
+  memmove((char*)mm->memory_region + prev_block->offset,
+          (char*)mm->memory_region + block_to_use->offset, block_to_use->size);
+  block_to_use->offset = prev_block->offset;
+  block_to_use->size   = combined_size;
+  block_to_use->prev   = prev_block->prev;
+  if (prev_block->prev != NULL) {
+    prev_block->prev->next = block_to_use;
+  } else {
+    mm->start_block = block_to_use;
+  }
+  if (mm->rover == prev_block) {
+    mm->rover = block_to_use;
+  }
+  block_pool_release(&mm->pool, prev_block);
+  mm->stats.merges++;
+
+  // 3) Devolver lo que sobra y rellenar la parte ocupada con el nombre:
+  if (combined_size > size) {
+    mm_realloc_shrink(mm, block_to_use, size);
+  }
+  block_to_use->requested = size;
+  memset(
+    (char*)mm->memory_region + block_to_use->offset,
+    name_table_str(&mm->name_table, &block_to_use->name)[0],
     block_to_use->size
   );
 
@@ -444,32 +876,36 @@ int mm_realloc_grow(MemoryManagement* mm, Block* block_to_use, size_t size) {
 /**************************************************************************************************
  * mm_realloc
  *
- *  1) Busca en la lista el bloque con nombre == name y free == false.
+ *  1) Busca en mm->names el bloque ocupado con nombre == name (el de menor offset si hay varios).
  *     Si no existe, devuelve error.
  *  2) Si size == block->size, no hace nada.
  *  3) Si size > block->size:
  *      - Llama a mm_realloc_grow. Si da EXIT_SUCCESS, asigna block->size = size; 
  *        de lo contrario, “simula fuga”: duplica nombre y llama a mm_alloc en otro lado. 
  *        Si mm_alloc tiene éxito, libera el nombre duplicado y no toca el bloque viejo.
+ *        Con --realloc=move, en lugar de la fuga, mm_realloc_move.
  *  4) Si size < block->size, llama a mm_realloc_shrink.
  */
-int mm_realloc(MemoryManagement* mm, const char* name, size_t size) {
-  Block* block_to_use = NULL;
-  Block* current      = mm->start_block;
-
+int mm_realloc(MemoryManagement* mm, NameView name, size_t size) {
   // 1) Encontrar el bloque con el mismo name:
-  while (current != NULL) {
-    if (!current->free && current->name != NULL && strcmp(current->name, name) == 0) {
-      block_to_use = current;
-      break;
+  BlockName block_name;
+  Block*    block_to_use = NULL;
+  if (name_table_find(&mm->name_table, name, &block_name)) {
+    if (mm->options.tags) {
+      return mm_tags_realloc(mm, &block_name, size);
     }
-    current = current->next;
+    block_to_use = name_index_find(&mm->names, &block_name);
   }
   if (block_to_use == NULL) {
-    fprintf(stderr, "mm_realloc: No se encontró bloque con nombre %s.\n", name);
+    fprintf(stderr, "mm_realloc: No se encontró bloque con nombre %.*s.\n", (int) name.length,
+            name.data);
     return EXIT_FAILURE;
   }
 
+  if (mm->strategy == STRATEGY_BUDDY) {
+    return mm_buddy_realloc(mm, block_to_use, size);
+  }
+
   // 2) Si el tamaño es el mismo, no hacemos nada:
   if (size == block_to_use->size) {
     return EXIT_SUCCESS;
@@ -479,35 +915,38 @@ int mm_realloc(MemoryManagement* mm, const char* name, size_t size) {
   if (size > block_to_use->size) {
     if (mm_realloc_grow(mm, block_to_use, size) == EXIT_SUCCESS) {
       // mm_realloc_grow ya rellenó con el nombre
-      block_to_use->size = size;
+      block_to_use->size      = size;
+      block_to_use->requested = size;
       return EXIT_SUCCESS;
     }
 
-    // Si no pudimos crecer en sitio, “simulamos fuga”:
-    // Duplicamos el nombre y llamamos a mm_alloc.... (si falla, devolvemos error)
-    char* name_copy = strdup(block_to_use->name);
-    if (name_copy == NULL) {
-      fprintf(stderr, "mm_realloc: No se pudo duplicar nombre para fuga: %s.\n", name);
-      return EXIT_FAILURE;
+    // Con --realloc=move se une con el anterior o se muda a otro bloque:
+    if (mm->options.realloc_move) {
+      return mm_realloc_move(mm, block_to_use, size);
     }
-    int err = mm_alloc(mm, name_copy, size);
-    free(name_copy);
+
+    // Si no pudimos crecer en sitio, “simulamos fuga”:
+    // Asignamos otro bloque con el mismo nombre (copiado por valor). Si falla, devolvemos error.
+    int err = mm_alloc_named(mm, &block_name, size, NULL);
     if (err != EXIT_SUCCESS) {
       // No pudo asignar en otro bloque
       return EXIT_FAILURE;
     }
     // Devolvemos EXIT_SUCCESS porque dejamos el bloque viejo tal como estaba (fuga real)
+    mm->stats.leaks++;
+    mm->stats.leaked_bytes += block_to_use->size;
     return EXIT_SUCCESS;
   }
 
   // 4) Si queremos achicar:
   if (size < block_to_use->size) {
-    if (mm_realloc_shrink(block_to_use, size) == EXIT_SUCCESS) {
+    block_to_use->requested = size;
+    if (mm_realloc_shrink(mm, block_to_use, size) == EXIT_SUCCESS) {
       // Rellenamos la parte ocupada con el nombre (primera letra)
-      if (block_to_use->name != NULL) {
+      if (!block_name_is_empty(&block_to_use->name)) {
         memset(
           (char*)mm->memory_region + block_to_use->offset,
-          block_to_use->name[0],
+          name_table_str(&mm->name_table, &block_to_use->name)[0],
           block_to_use->size
         );
       }
@@ -518,7 +957,7 @@ int mm_realloc(MemoryManagement* mm, const char* name, size_t size) {
   }
 
   // Nunca debería llegar aquí:
-  fprintf(stderr, "mm_realloc: Caso inesperado para %s.\n", name);
+  fprintf(stderr, "mm_realloc: Caso inesperado para %.*s.\n", (int) name.length, name.data);
   return EXIT_FAILURE;
 }
 
@@ -526,68 +965,204 @@ int mm_realloc(MemoryManagement* mm, const char* name, size_t size) {
  * mm_free_join
  *
  *  Después de liberar un bloque (mm_free ha marcado free = true), 
- *  se une con bloques vecinos libres (tanto siguiente como anterior).
+ *  se une con bloques vecinos libres (tanto siguiente como anterior). Los vecinos absorbidos
+ *  salen de los índices de libres; el bloque resultante de la fusión se inserta al final.
+ *  Si mm->rover apuntaba a un nodo que desaparece, pasa al bloque que lo absorbió.
  */
-void mm_free_join(Block* block_to_use) {
-  // 1) Si el siguiente bloque está libre, lo fusionamos:
-  while (block_to_use->next && block_to_use->next->free) {
+void mm_free_join(MemoryManagement* mm, Block* block_to_use) {
+  block_to_use->dirty.since = 0;  // eran bytes ocupados: todo el bloque queda sucio
+  mm_purge_touch(mm, block_to_use, block_to_use->offset,
+                 block_to_use->offset + block_to_use->size);
+
+  // 1) Si el siguiente bloque está libre (y en el mismo segmento), lo fusionamos:
+  while (block_to_use->next && block_to_use->next->free &&
+         !mm_segment_start(mm, block_to_use->next->offset)) {
     Block* next_block = block_to_use->next;
+    mm_index_remove(mm, next_block);
 
     // Aumentamos el tamaño del bloque actual:
+    mm_purge_absorb(block_to_use, next_block);
     block_to_use->size += next_block->size;
     block_to_use->next = next_block->next;
     if (next_block->next) {
       next_block->next->prev = block_to_use;
     }
 
-    // Liberamos metadata de next_block:
-    if (next_block->name) free(next_block->name);
-    free(next_block);
+    // Devolvemos la metadata de next_block al pool (el rover pasa al bloque que lo absorbió):
+    if (mm->rover == next_block) {
+      mm->rover = block_to_use;
+    }
+    block_pool_release(&mm->pool, next_block);
+    mm->stats.merges++;
   }
 
   // 2) Si el bloque anterior existe y está libre, fusionamos hacia atrás:
-  while (block_to_use->prev && block_to_use->prev->free) {
+  while (block_to_use->prev && block_to_use->prev->free &&
+         !mm_segment_start(mm, block_to_use->offset)) {
     Block* prev_block = block_to_use->prev;
+    mm_index_remove(mm, prev_block);
 
+    mm_purge_absorb(prev_block, block_to_use);
     prev_block->size += block_to_use->size;
     prev_block->next = block_to_use->next;
     if (block_to_use->next) {
       block_to_use->next->prev = prev_block;
     }
-    // Liberamos metadata de block_to_use (ya es libre y name == NULL):
-    if (block_to_use->name) free(block_to_use->name);
-    free(block_to_use);
+    // Devolvemos la metadata de block_to_use al pool (ya es libre y sin nombre):
+    if (mm->rover == block_to_use) {
+      mm->rover = prev_block;
+    }
+    block_pool_release(&mm->pool, block_to_use);
+    mm->stats.merges++;
     block_to_use = prev_block;
   }
+
+  // 3) El bloque final (ya con su tamaño definitivo) entra a los índices de libres y, con
+  //    --purge=eager, devuelve sus páginas:
+  mm_index_insert(mm, block_to_use);
+  mm_purge_freed(mm, block_to_use);
 }
 
 /**************************************************************************************************
  * mm_free
  *
- *  Busca el bloque con name == name (y free == false). Si no está, error.
+ *  Busca en mm->names el bloque con name == name (y free == false). Si no está, error.
  *  Libera su metadata (free(name)), marca free = true y name = NULL. 
  *  Luego, (opcionalmente) hace memset en la región de datos con 0 para “borrar”.
  *  Finalmente invoca a mm_free_join(...) para unir bloques libres adyacentes.
  */
-int mm_free(MemoryManagement* mm, const char* name) {
-  Block* block_to_use = NULL;
-  Block* current      = mm->start_block;
-
-  while (current != NULL) {
-    if (!current->free && current->name != NULL && strcmp(current->name, name) == 0) {
-      block_to_use = current;
-      break;
+int mm_free(MemoryManagement* mm, NameView name) {
+  BlockName block_name;
+  Block*    block_to_use = NULL;
+  if (name_table_find(&mm->name_table, name, &block_name)) {
+    if (mm->options.tags) {
+      return mm_tags_free(mm, &block_name);
     }
-    current = current->next;
+    block_to_use = name_index_find(&mm->names, &block_name);
   }
   if (block_to_use == NULL) {
-    fprintf(stderr, "mm_free: No se encontró bloque con nombre %s.\n", name);
+    fprintf(stderr, "mm_free: No se encontró bloque con nombre %.*s.\n", (int) name.length,
+            name.data);
     return EXIT_FAILURE;
   }
 
-  // 1) Liberamos la metadata (name):
-  free(block_to_use->name);
-  block_to_use->name = NULL;
+  // Con arenas, otro hilo puede haber encolado ya un FREE por handle del mismo bloque:
+  int live = BLOCK_LIVE;
+  if (!atomic_compare_exchange_strong_explicit(&block_to_use->state, &live, BLOCK_RELEASED,
+                                               memory_order_relaxed, memory_order_relaxed)) {
+    fprintf(stderr, "mm_free: El bloque %.*s ya tiene un FREE pendiente.\n", (int) name.length,
+            name.data);
+    return EXIT_FAILURE;
+  }
+  mm_free_block(mm, block_to_use);
+  return EXIT_SUCCESS;
+}
+
+/**************************************************************************************************
+ * mm_coalesce
+ *
+ *  Cada bloque libre absorbe a los libres que le siguen en la lista (como mm_free_join, los
+ *  vecinos cuentan como contiguos aunque entre ellos haya bytes perdidos) y entra una sola vez
+ *  a los índices con su tamaño final: un tramo de k libres cuesta k - 1 nodos devueltos al pool
+ *  y ninguna búsqueda.
+ */
+void mm_coalesce(MemoryManagement* mm) {
+  mm->lazy_frees = 0;
+  mm->stats.coalesce_sweeps++;
+
+  for (Block* block = mm->start_block; block != NULL; block = block->next) {
+    Block* next = block->next;
+    if (!block->free || next == NULL || !next->free || mm_segment_start(mm, next->offset)) {
+      continue;
+    }
+
+    mm_index_remove(mm, block);
+    while (next != NULL && next->free && !mm_segment_start(mm, next->offset)) {
+      mm_index_remove(mm, next);
+      mm_purge_absorb(block, next);
+      block->size += next->size;
+      block->next  = next->next;
+      if (next->next != NULL) {
+        next->next->prev = block;
+      }
+      if (mm->rover == next) {
+        mm->rover = block;
+      }
+      block_pool_release(&mm->pool, next);
+      mm->stats.merges++;
+      next = block->next;
+    }
+    mm_index_insert(mm, block);
+    mm_purge_freed(mm, block);
+  }
+}
+
+/**************************************************************************************************
+ * mm_cache_flush_size
+ *
+ *  Vacía la pila de 'size' bytes: cada bloque pasa a libre y se une con sus vecinos, como si su
+ *  FREE recién llegara.
+ */
+static void mm_cache_flush_size(MemoryManagement* mm, size_t size) {
+  Block* block;
+  while ((block = block_cache_pop(&mm->cache, size)) != NULL) {
+    mm->stats.cached_bytes -= size;
+    mm->stats.live_bytes   += size;  // mm_free_join lo pasa a libre
+    block->requested = 0;
+    block->free      = true;
+    mm_free_join(mm, block);
+  }
+}
+
+/**************************************************************************************************
+ * mm_cache_put
+ *
+ *  Si la pila del tamaño está llena, primero se vacía (desborde); el bloque nuevo queda arriba.
+ *  El bloque sigue ocupado para la lista, pero sin nombre ni bytes pedidos.
+ */
+static void mm_cache_put(MemoryManagement* mm, Block* block_to_use) {
+  if (mm->cache.counts[block_to_use->size] >= mm->options.cache_count) {
+    mm_cache_flush_size(mm, block_to_use->size);
+    mm->stats.cache_flushes++;
+  }
+
+  block_to_use->requested = 0;
+  block_cache_push(&mm->cache, block_to_use);
+  mm->stats.live_bytes   -= block_to_use->size;
+  mm->stats.cached_bytes += block_to_use->size;
+}
+
+/**************************************************************************************************
+ * mm_cache_flush
+ */
+void mm_cache_flush(MemoryManagement* mm) {
+  if (mm->cache.blocks == 0) {
+    return;
+  }
+  for (size_t size = 1; size <= BLOCK_CACHE_MAX_SIZE && mm->cache.blocks > 0; size++) {
+    mm_cache_flush_size(mm, size);
+  }
+  mm->stats.cache_flushes++;
+}
+
+/**************************************************************************************************
+ * mm_free_block
+ *
+ *  Cuerpo de mm_free una vez encontrado el bloque (también lo usan las arenas para los FREE
+ *  diferidos, que ya tienen el Block*).
+ */
+void mm_free_block(MemoryManagement* mm, Block* block_to_use) {
+  atomic_store_explicit(&block_to_use->state, BLOCK_RELEASED, memory_order_relaxed);
+
+  // 1) Vaciamos la metadata (name), sacándolo antes del índice de nombres:
+  name_index_remove(&mm->names, block_to_use);
+  block_name_clear(&block_to_use->name);
+
+  // En el motor buddy solo se fusiona con el buddy, no con cualquier vecino libre:
+  if (mm->strategy == STRATEGY_BUDDY) {
+    mm_buddy_free(mm, block_to_use);
+    return;
+  }
 
   // 2) (Opcional) Borramos la región de datos para no “ver” el contenido
   //    Si queremos simular fuga, simplemente omitimos este memset. 
@@ -595,13 +1170,30 @@ int mm_free(MemoryManagement* mm, const char* name) {
   //    dejaremos esto comentado:
   // memset((char*)mm->memory_region + block_to_use->offset, 0, block_to_use->size);
 
-  // 3) Marcamos el bloque como libre:
+  // 3) Con --cache, un bloque chico queda guardado para el próximo ALLOC de su tamaño:
+  if (mm->options.cache && block_cache_fits(block_to_use->size)) {
+    mm_cache_put(mm, block_to_use);
+    return;
+  }
+
+  // 4) Marcamos el bloque como libre:
   block_to_use->free = true;
 
-  // 4) Unimos con vecinos libres:
-  mm_free_join(block_to_use);
+  // 5) Con --coalesce=lazy solo vuelve a los índices; la unión la hace la próxima pasada:
+  if (mm->options.coalesce == COALESCE_LAZY) {
+    block_to_use->dirty.since = 0;
+    mm_purge_touch(mm, block_to_use, block_to_use->offset,
+                   block_to_use->offset + block_to_use->size);
+    mm_index_insert(mm, block_to_use);
+    mm_purge_freed(mm, block_to_use);
+    if (mm->options.coalesce_period != 0 && ++mm->lazy_frees >= mm->options.coalesce_period) {
+      mm_coalesce(mm);
+    }
+    return;
+  }
 
-  return EXIT_SUCCESS;
+  // 6) Unimos con vecinos libres:
+  mm_free_join(mm, block_to_use);
 }
 
 /**************************************************************************************************
@@ -616,22 +1208,101 @@ int mm_free(MemoryManagement* mm, const char* name) {
  *  (Índice de bloque, offset real en bytes, “Free” o “Name: XXX”, tamaño en bytes).
  */
 void mm_print(const MemoryManagement* mm) {
+  if (mm->options.tags) {
+    mm_tags_print(mm);
+    return;
+  }
+
   printf("Memory Management:\n");
   int    i       = 0;
   Block* current = mm->start_block;
 
   while (current != NULL) {
-    printf("Block: %d, Offset: %zu, ", i, current->offset);
+    printf("Block: %d, Offset: %zu, ", i, mm->base_offset + current->offset);
     if (current->free) {
       printf("Free, ");
+    } else if (block_name_is_empty(&current->name)) {
+      printf("Cached, ");  // en la caché de --cache: liberado pero todavía sin unir
     } else {
-      printf("Name: %s, ", current->name);
+      printf("Name: %s, ", name_table_str(&mm->name_table, &current->name));
     }
     printf("Size: %zu\n", current->size);
 
     i++;
     current = current->next;
   }
+
+  if (mm->strategy == STRATEGY_BUDDY) {
+    printf("Internal fragmentation: %zu bytes\n", mm->internal_fragmentation);
+  }
+  if (mm->options.grow) {
+    printf("Segments: %zu, Heap size: %zu\n", mm->segment_count, mm->total_size);
+  }
+}
+
+/**************************************************************************************************
+ * mm_largest_free
+ *
+ *  El árbol de libres tiene el máximo en su borde derecho y TLSF en su subclase no vacía más
+ *  alta; con --tags se recorre la lista de libres (nunca los ocupados).
+ */
+size_t mm_largest_free(const MemoryManagement* mm) {
+  if (mm->options.tags) {
+    return mm_tags_largest_free(mm);
+  }
+
+  const Block* largest;
+  if (mm->strategy == STRATEGY_TLSF) {
+    largest = tlsf_index_max(&mm->tlsf);
+  } else {
+    size_t steps = 0;
+    largest      = free_tree_max(&mm->free_tree, &steps);
+  }
+  return largest != NULL ? largest->size : 0;
+}
+
+/**************************************************************************************************
+ * mm_stats_print
+ */
+void mm_stats_print(const MemoryManagement* mm) {
+  const MMStats* stats         = &mm->stats;
+  size_t         largest       = mm_largest_free(mm);
+  double         fragmentation = 0.0;
+  if (stats->free_bytes > 0) {
+    fragmentation = 100.0 * (1.0 - (double) largest / (double) stats->free_bytes);
+  }
+
+  printf("Stats:\n");
+  printf("Live bytes: %zu, Free bytes: %zu, Free blocks: %zu, Largest free: %zu\n",
+         stats->live_bytes, stats->free_bytes, stats->free_blocks, largest);
+  printf("External fragmentation: %.2f%%\n", fragmentation);
+  printf("Splits: %zu, Merges: %zu, Leaks: %zu (%zu bytes), Lost bytes: %zu\n", stats->splits,
+         stats->merges, stats->leaks, stats->leaked_bytes, stats->lost_bytes);
+  printf("Moves: %zu (%zu bytes copied)\n", stats->moves, stats->moved_bytes);
+  printf("Compactions: %zu (%zu bytes moved)\n", stats->compactions, stats->compacted_bytes);
+  printf("Purges: %zu (%zu bytes)\n", stats->purges, stats->purged_bytes);
+  printf("Segments: %zu (%zu grows), Heap size: %zu\n", mm->segment_count, stats->grows,
+         mm->total_size);
+
+  printf("Coalesce sweeps: %zu, Block nodes: %zu acquired, %zu released, %zu peak\n",
+         stats->coalesce_sweeps, mm->pool.acquires, mm->pool.releases, mm->pool.high_water);
+
+  size_t lookups  = stats->cache_hits + stats->cache_misses;
+  double hit_rate = lookups > 0 ? 100.0 * (double) stats->cache_hits / (double) lookups : 0.0;
+  printf("Cache hits: %zu, Misses: %zu (%.2f%% hit rate), Flushes: %zu, Cached bytes: %zu\n",
+         stats->cache_hits, stats->cache_misses, hit_rate, stats->cache_flushes,
+         stats->cached_bytes);
+}
+
+/**************************************************************************************************
+ * mm_metadata_bytes
+ */
+size_t mm_metadata_bytes(const MemoryManagement* mm) {
+  const NameTable* table = &mm->name_table;
+  return mm->pool.metadata_bytes + mm->names.capacity * sizeof(NameIndexEntry) +
+         (mm->options.tags ? mm->tags_names.capacity * sizeof(TagsIndexEntry) : 0) +
+         table->chars_capacity + table->offsets_capacity * sizeof(size_t) +
+         table->slots_capacity * sizeof(uint32_t);
 }
 
 /**************************************************************************************************
@@ -642,8 +1313,14 @@ void mm_print(const MemoryManagement* mm) {
  *    - CMD_REALLOC -> mm_realloc(mm, command->name, command->size)
  *    - CMD_FREE   -> mm_free(mm, command->name)
  *    - CMD_PRINT  -> mm_print(mm)
+ *    - CMD_STATS  -> mm_stats_print(mm)
+ *    - CMD_COMPACT -> mm_compact_print(mm, command->size)
+ *    - CMD_PURGE  -> mm_purge_print(mm)
+ *  Antes avanza el reloj de --purge=decay.
  */
 int mm_execute_command(MemoryManagement* mm, const Command* command) {
+  mm_purge_tick(mm);
+
   switch (command->type) {
     case CMD_ALLOC:
       return mm_alloc(mm, command->name, command->size);
@@ -654,6 +1331,13 @@ int mm_execute_command(MemoryManagement* mm, const Command* command) {
     case CMD_PRINT:
       mm_print(mm);
       return EXIT_SUCCESS;
+    case CMD_STATS:
+      mm_stats_print(mm);
+      return EXIT_SUCCESS;
+    case CMD_COMPACT:
+      return mm_compact_print(mm, command->size);
+    case CMD_PURGE:
+      return mm_purge_print(mm);
     default:
       fprintf(stderr,
               "mm_execute_command: Tipo de comando desconocido: %d.\n",
@@ -665,52 +1349,38 @@ int mm_execute_command(MemoryManagement* mm, const Command* command) {
 /**************************************************************************************************
  * mm_start
  *
- *  1) Abre el archivo 'filename' para lectura.
- *  2) Lee cada línea con fgets(buffer,...).
- *  3) Si la línea está vacía o comienza con '#', la ignora.
- *  4) Invoca a parse_command(buffer, &command). Si falla, libera command.name y sale con ERROR.
- *  5) Invoca a mm_execute_command(mm, &command). Si falla, libera command.name y sale con ERROR.
- *  6) Si command.name != NULL, libera command.name antes de leer la siguiente línea.
- *  7) Al finalizar, cierra el archivo y devuelve EXIT_SUCCESS.
+ *  1) Mapea el archivo 'filename' con reader_open.
+ *  2) Pide cada línea con reader_next_line (ya saltea las vacías y las que comienzan con '#').
+ *  3) Invoca a parse_command(line, length, &command): el nombre queda como NameView sobre el
+ *     archivo mapeado, sin strdup. Si falla, sale con ERROR.
+ *  4) Invoca a mm_execute_command(mm, &command). Si falla, sale con ERROR.
+ *  5) Al finalizar, libera el mapeo y devuelve EXIT_SUCCESS.
  */
 int mm_start(MemoryManagement* mm, const char* filename) {
-  FILE* file = fopen(filename, "r");
-  if (file == NULL) {
+  Reader reader;
+  if (reader_open(&reader, filename) != EXIT_SUCCESS) {
     fprintf(stderr, "mm_start: No se pudo abrir el archivo: %s\n", filename);
     return EXIT_FAILURE;
   }
 
-  char   buffer[256];
-  while (fgets(buffer, sizeof(buffer), file)) {
-    // Ignorar líneas vacías o comentarios
-    if (buffer[0] == '\n' || buffer[0] == '#') {
-      continue;
-    }
-
+  const char* line;
+  size_t      length;
+  while (reader_next_line(&reader, &line, &length)) {
     Command command;
-    command.name = NULL;
-    command.size = 0;
 
-    if (parse_command(buffer, &command) != EXIT_SUCCESS) {
-      if (command.name) free(command.name);
-      fclose(file);
-      fprintf(stderr, "mm_start: Error al parsear comando: %s", buffer);
+    if (parse_command(line, length, &command) != EXIT_SUCCESS) {
+      fprintf(stderr, "mm_start: Error al parsear comando: %.*s\n", (int) length, line);
+      reader_close(&reader);
       return EXIT_FAILURE;
     }
 
     if (mm_execute_command(mm, &command) != EXIT_SUCCESS) {
-      if (command.name) free(command.name);
-      fclose(file);
-      fprintf(stderr, "mm_start: Error al ejecutar comando: %s", buffer);
+      fprintf(stderr, "mm_start: Error al ejecutar comando: %.*s\n", (int) length, line);
+      reader_close(&reader);
       return EXIT_FAILURE;
     }
-
-    if (command.name) {
-      free(command.name);
-      command.name = NULL;
-    }
   }
 
-  fclose(file);
+  reader_close(&reader);
   return EXIT_SUCCESS;
 }
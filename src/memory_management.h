@@ -6,74 +6,162 @@
 #include <stdbool.h>
 #include <stddef.h>
 
+#include "block.h"
+#include "block_cache.h"
+#include "block_pool.h"
 #include "command.h"
+#include "free_lists.h"
+#include "free_tree.h"
+#include "name_index.h"
+#include "name_table.h"
+#include "options.h"
+#include "stats.h"
 #include "strategy.h"
+#include "tags_index.h"
+#include "tlsf_index.h"
 
 /**
- * Cada bloque de la lista representa:
- *  - free == true  ⇾ un trozo libre de 'size' bytes a partir de 'offset' bytes desde memory_region.
- *  - free == false ⇾ un trozo ocupado con nombre 'name', 'size' bytes, en 'offset' bytes desde memory_region.
+ * Umbral de split: un remanente de hasta este tamaño no se separa en un bloque propio.
+ * Corresponde al sizeof(Block) original (bool + char* + 2 size_t + 2 punteros); se fija aquí
+ * para que agregar campos de índice a Block no cambie las decisiones de ubicación.
  */
-typedef struct Block {
-  bool           free;       // true = disponible, false = ocupado
-  char*          name;       // nombre de variable (p.ej. "A", "B", …); NULL si libre
-  size_t         size;       // número de bytes que ocupa este bloque
-  size_t         offset;     // desplazamiento (en bytes) desde memory_region
-  struct Block*  next;       // siguiente bloque en la lista
-  struct Block*  prev;       // bloque anterior en la lista
-} Block;
+#define MM_SPLIT_THRESHOLD 48
+
+#define MM_MAX_SEGMENTS 64  // segmentos de --grow, contando la región inicial (ver segment.h)
 
 /**
  * Estructura principal de manejo de memoria:
- *  - strategy: enum { FIRST, BEST, WORST }
+ *  - strategy: enum { FIRST, BEST, WORST, NEXT, BUDDY, TLSF }
  *  - total_size: tamaño total (en bytes) del bloque grande pedido al SO
- *  - memory_region: puntero al bloque grande (void*) que se pidió con malloc()
+ *  - memory_region: puntero al bloque grande (void*), mapeado con mmap por region_map
  *  - start_block: primer nodo de la lista doblemente enlazada de Block
+ *  - free_lists: índice de los bloques libres por clase de tamaño (potencias de dos)
+ *  - free_tree: los mismos bloques libres en un árbol balanceado por (size, offset)
+ *  - tlsf: con TLSF, índice de dos niveles que reemplaza a free_lists y free_tree (ambos quedan
+ *    vacíos para que ninguna operación pague el O(log n) del árbol)
+ *  - names: tabla hash de nombre -> bloques ocupados, para FREE y REALLOC
+ *  - cache: con --cache, bloques chicos liberados y todavía sin unir, por tamaño exacto
+ *  - name_table: nombres largos internados (los cortos van inline en cada Block)
+ *  - pool: slabs de donde salen (y a donde vuelven) todos los nodos Block
+ *  - rover: cursor de next-fit; la próxima búsqueda NEXT arranca desde este bloque
+ *  - internal_fragmentation: suma de (size - requested) de los bloques ocupados; solo el motor
+ *    buddy redondea tamaños, en las demás estrategias es siempre 0
+ *  - options: opciones de la línea de comandos (ver options.h)
+ *  - owns_region: memory_region salió de mm_init (region_map) y la libera mm_destroy; con
+ *    mm_init_region la región es ajena
+ *  - base_offset: posición de memory_region dentro de una región compartida (arenas); PRINT
+ *    suma este valor a cada offset
+ *  - last_alloc: bloque entregado por el último ALLOC exitoso (o por la “fuga” o la mudanza de
+ *    REALLOC); NULL con --tags, donde no hay nodos Block
+ *  - stats: estadísticas de ocupación y fragmentación, siempre al día (ver stats.h)
+ *  - searches / search_steps: búsquedas de bloque libre hechas (mm_find_block, y sus equivalentes
+ *    con BUDDY y --tags) y nodos examinados en total (bloques, nodos del árbol o bitmaps según la
+ *    estrategia); search_steps / searches es el largo medio de búsqueda
+ *  - purge_clock: comandos ejecutados + 1 (nunca 0), para BlockDirty::since (ver purge.h)
+ *  - lazy_frees: FREE desde la última pasada de mm_coalesce con --coalesce=lazy
+ *  - region_capacity: bytes reservados en memory_region; total_size salvo con --grow, donde es
+ *    el tope hasta el que pueden agregarse segmentos
+ *  - segment_count / segment_starts: segmentos del heap y offset donde empieza cada uno, en
+ *    orden (el primero es la región inicial, en 0)
+ *  - segment_guard: lo reservado detrás de total_size está con PROT_NONE y mm_grow lo habilita
+ *  - tags_end / tags_free_head / tags_rover: con options.tags, fin de la zona de chunks, primer
+ *    chunk libre y cursor de next-fit (offsets dentro de memory_region; ver boundary_tags.h).
+ *    En ese modo no hay nodos Block: start_block y rover quedan en NULL.
+ *  - tags_names: con options.tags, offsets de los chunks ocupados por nombre (ver tags_index.h)
  */
 typedef struct {
-  StrategyType strategy;      // estrategia de asignación (FIRST, BEST o WORST)
+  StrategyType strategy;      // estrategia de asignación (FIRST, BEST, WORST, NEXT, BUDDY o TLSF)
   size_t       total_size;    // tamaño total en bytes del bloque “grande”
-  void*        memory_region; // puntero al bloque contiguo reservado con malloc(total_size)
+  void*        memory_region; // puntero al bloque contiguo mapeado con region_map(total_size)
   Block*       start_block;   // head de la lista (un único bloque libre inicial)
+  FreeLists    free_lists;    // bloques libres segregados por clase de tamaño
+  FreeTree     free_tree;     // bloques libres ordenados por (size, offset)
+  TlsfIndex    tlsf;          // bloques libres por (fl, sl), solo con TLSF
+  NameIndex    names;         // bloques ocupados por nombre
+  BlockCache   cache;         // bloques liberados sin unir, por tamaño (--cache)
+  NameTable    name_table;    // nombres que no entran inline en BlockName
+  BlockPool    pool;          // nodos Block (high_water y metadata_bytes como contadores)
+  Block*       rover;         // cursor de next-fit (siempre un nodo vivo de la lista)
+  size_t       internal_fragmentation;  // bytes redondeados de más dentro de bloques ocupados
+  MMOptions    options;       // opciones extra (--tags, ...)
+  bool         owns_region;   // mm_destroy hace region_unmap(memory_region)
+  size_t       base_offset;   // offset de memory_region dentro de la región compartida
+  Block*       last_alloc;    // último bloque asignado (para quien necesita el Block*)
+  MMStats      stats;         // bytes vivos/libres, splits, merges y fugas (O(1) de leer)
+  size_t       searches;      // búsquedas de bloque libre
+  size_t       search_steps;  // nodos examinados por esas búsquedas
+  size_t       purge_clock;   // comandos ejecutados + 1: reloj de BlockDirty y de --purge=decay
+  size_t       lazy_frees;    // FREE sin unir desde la última pasada de mm_coalesce
+  size_t       region_capacity;  // bytes reservados (total_size salvo con --grow)
+  size_t       segment_count;    // segmentos del heap (1 sin --grow)
+  size_t       segment_starts[MM_MAX_SEGMENTS];  // offset de inicio de cada segmento
+  bool         segment_guard;    // la reserva sin usar está protegida (PROT_NONE)
+  size_t       tags_end;      // con --tags: bytes de memory_region usados por chunks
+  size_t       tags_free_head;  // con --tags: offset del primer chunk libre (TAGS_NONE si no hay)
+  size_t       tags_rover;    // con --tags: cursor de next-fit sobre la lista de libres
+  TagsIndex    tags_names;    // con --tags: chunks ocupados por nombre
 } MemoryManagement;
 
 /**
  * mm_init:
- *  - strategy: cuál algoritmo usar (FIRST, BEST, WORST)
+ *  - strategy: cuál algoritmo usar (FIRST, BEST, WORST, NEXT, BUDDY, TLSF)
  *  - size: tamaño (en bytes) para pedir al SO
+ *  - options: opciones extra; NULL equivale a todas en cero
  * 
- *  Reserva memory_region = malloc(size) y crea el bloque inicial libre:
- *    offset = 0, size = total_size, free = true, name = NULL.
+ *  Reserva memory_region = region_map(size) (mmap anónimo) y crea el bloque inicial libre:
+ *    offset = 0, size = total_size, free = true, name vacío.
+ *  Con BUDDY, ese bloque se parte en potencias de dos alineadas (mm_buddy_init).
+ *  Con options->grow reserva el tope de crecimiento y deja accesibles solo 'size' bytes.
+ *  Con options->tags no crea ningún Block: escribe un chunk libre en banda (mm_tags_init).
+ */
+int mm_init(MemoryManagement* mm, StrategyType strategy, size_t size, const MMOptions* options);
+
+/**
+ * mm_init_region:
+ *  - Igual que mm_init pero sobre 'size' bytes ya reservados en 'region', que mm_destroy no
+ *    libera. base_offset es la posición de region dentro de la región compartida (ver arena.h).
  */
-int mm_init(MemoryManagement* mm, StrategyType strategy, size_t size);
+int mm_init_region(MemoryManagement* mm, StrategyType strategy, void* region, size_t size,
+                   size_t base_offset, const MMOptions* options);
 
 /**
  * mm_destroy:
- *  - Libera todos los bloques de la lista (metadata) y libera memory_region.
+ *  - Libera los slabs del pool de nodos (toda la metadata), las tablas de nombres y memory_region.
  */
 void mm_destroy(MemoryManagement* mm);
 
 /**
  * mm_alloc:
- *  - name: nombre de la variable (por ejemplo, "A", "B"…)
+ *  - name: nombre de la variable (por ejemplo, "A", "B"…), prestado: no hace falta que viva
+ *    después de la llamada
  *  - size: cuántos bytes queremos reservar
  * 
- *  Encuentra un bloque adecuado según strategy, hace split si es necesario,
- *  guarda name en Block, marca free = false, y sobre la región de datos 
- *  correspondiente hace memset con el primer carácter de name.
+ *  Encuentra un bloque adecuado según strategy, hace split si es necesario (con BUDDY delega en
+ *  mm_buddy_alloc),
+ *  guarda name en Block (inline o internado, sin strdup), marca free = false, y sobre la
+ *  región de datos correspondiente hace memset con el primer carácter de name.
  */
-int mm_alloc(MemoryManagement* mm, const char* name, size_t size);
+int mm_alloc(MemoryManagement* mm, NameView name, size_t size);
+
+/**
+ * mm_try_alloc:
+ *  - Como mm_alloc (una sola búsqueda, con todos sus reintentos), pero si no hay lugar deja
+ *    *no_room en true y falla sin imprimir: sirve para probar otra arena antes de fallar. Los
+ *    demás errores se imprimen y dejan *no_room en false. Con no_room == NULL es mm_alloc.
+ */
+int mm_try_alloc(MemoryManagement* mm, NameView name, size_t size, bool* no_room);
 
 /**
  * mm_alloc_split:
  *  - block_to_use: bloque libre con tamaño >= size
  *  - size: tamaño deseado para el bloque ocupado
  * 
- *  Divide block_to_use en dos, si el remanente es > sizeof(Block). 
+ *  Divide block_to_use en dos, si el remanente es > MM_SPLIT_THRESHOLD. 
  *  El bloque original queda con size = size, 
- *  y el nuevo bloque libre se crea con el resto (offset ajustado).
+ *  y el nuevo bloque libre se crea con el resto (offset ajustado) y se agrega a los índices de libres.
+ *  block_to_use no debe estar en los índices de libres al llamar.
  */
-int mm_alloc_split(Block* block_to_use, size_t size);
+int mm_alloc_split(MemoryManagement* mm, Block* block_to_use, size_t size);
 
 /**
  * mm_realloc:
@@ -82,10 +170,12 @@ int mm_alloc_split(Block* block_to_use, size_t size);
  *  
  *  Si size == size_actual, no hace nada.
  *  Si size > size_actual, intenta crecer el bloque (fusiones). Si no cabe, simula fuga:
- *    duplica el bloque en otro lugar y deja el viejo sin liberar.
+ *    duplica el bloque en otro lugar y deja el viejo sin liberar (con --realloc=move, en
+ *    cambio, llama a mm_realloc_move).
  *  Si size < size_actual, achica y crea un bloque libre con el remanente.
+ *  Con BUDDY delega en mm_buddy_realloc.
  */
-int mm_realloc(MemoryManagement* mm, const char* name, size_t size);
+int mm_realloc(MemoryManagement* mm, NameView name, size_t size);
 
 /**
  * mm_realloc_grow:
@@ -99,33 +189,78 @@ int mm_realloc(MemoryManagement* mm, const char* name, size_t size);
  */
 int mm_realloc_grow(MemoryManagement* mm, Block* block_to_use, size_t size);
 
+/**
+ * mm_realloc_move:
+ *  - block_to_use: bloque ocupado que mm_realloc_grow no pudo expandir
+ *  - size: nuevo tamaño (mayor al actual)
+ *
+ *  Si el bloque anterior está libre y anterior + bloque (+ siguiente, si está libre) >= size,
+ *  los une, mueve el contenido (memmove) al comienzo y devuelve el remanente. Si no, asigna otro
+ *  bloque con el mismo nombre, copia el contenido y libera el viejo. Con BUDDY solo se muda
+ *  (con --tags lo resuelve mm_tags_realloc). Si no hay lugar en ningún lado devuelve
+ *  EXIT_FAILURE y el bloque queda como estaba.
+ */
+int mm_realloc_move(MemoryManagement* mm, Block* block_to_use, size_t size);
+
 /**
  * mm_realloc_shrink:
  *  - block_to_use: bloque ocupado
  *  - size: tamaño menor al actual
  * 
- *  Corta block_to_use a 'size' bytes, crea un nuevo bloque libre con el remanente.
+ *  Corta block_to_use a 'size' bytes, crea un nuevo bloque libre con el remanente
+ *  y lo agrega a los índices de libres.
  */
-int mm_realloc_shrink(Block* block_to_use, size_t size);
+int mm_realloc_shrink(MemoryManagement* mm, Block* block_to_use, size_t size);
 
 /**
  * mm_free:
  *  - name: nombre de la variable a liberar
  * 
- *  Busca el bloque con ese name. Si no lo encuentra, error.
- *  Libera su metadata(name), marca free = true, y llama a mm_free_join() 
- *  para unir bloques libres adyacentes.
+ *  Busca el bloque con ese name en mm->names. Si no lo encuentra, error.
+ *  Vacía su metadata(name), marca free = true, y llama a mm_free_join() 
+ *  para unir bloques libres adyacentes (con BUDDY, mm_buddy_free fusiona solo con su buddy).
+ *  Con --cache, un bloque de hasta BLOCK_CACHE_MAX_SIZE bytes va a la caché sin unirse; con
+ *  --coalesce=lazy el bloque solo se marca libre y la unión queda para mm_coalesce.
+ *  Nunca une bloques de segmentos distintos (ver segment.h).
+ */
+int mm_free(MemoryManagement* mm, NameView name);
+
+/**
+ * mm_free_block:
+ *  - block_to_use: bloque ocupado de esta mm (no vale con --tags)
+ *
+ *  Lo que hace mm_free después de encontrar el bloque: lo saca del índice de nombres, lo marca
+ *  libre y lo une con sus vecinos.
  */
-int mm_free(MemoryManagement* mm, const char* name);
+void mm_free_block(MemoryManagement* mm, Block* block_to_use);
 
 /**
  * mm_free_join:
  *  - block_to_use: bloque recién liberado
  *  
  *  Si el siguiente bloque está libre, fusiona con él. Repite mientras haya bloques libres 
- *  contiguos adelante o atrás.
+ *  contiguos adelante o atrás. Los vecinos absorbidos salen de los índices de libres y el
+ *  bloque resultante se agrega (block_to_use no debe estar en los índices al llamar).
+ *  Si mm->rover apuntaba a un nodo absorbido, pasa al bloque resultante.
+ */
+void mm_free_join(MemoryManagement* mm, Block* block_to_use);
+
+/**
+ * mm_coalesce:
+ *  - Con --coalesce=lazy: recorre la lista una vez y une cada tramo de bloques libres
+ *    consecutivos (del mismo segmento) en uno solo. Corre cuando un ALLOC no encuentra bloque y
+ *    cada options.coalesce_period FREE; no hace falta llamarla en modo eager, donde nunca hay
+ *    dos libres seguidos.
  */
-void mm_free_join(Block* block_to_use);
+void mm_coalesce(MemoryManagement* mm);
+
+/**
+ * mm_cache_flush:
+ *  - Devuelve todos los bloques de la caché de --cache a los libres, uniéndolos con sus vecinos
+ *    (mm_free_join). Lo hacen un ALLOC que no encuentra bloque y mm_compact; una pila que se
+ *    llena se vacía sola antes de recibir el bloque nuevo.
+ */
+void mm_cache_flush(MemoryManagement* mm);
 
 /**
  * mm_print:
@@ -133,6 +268,8 @@ void mm_free_join(Block* block_to_use);
  * 
  *  Imprime línea por línea todos los bloques (libres u ocupados), mostrando:
  *    índice, offset, estado (Free o Name), tamaño.
+ *  Con BUDDY agrega al final la fragmentación interna total, y con --grow la cantidad de
+ *  segmentos.
  */
 void mm_print(const MemoryManagement* mm);
 
@@ -141,9 +278,9 @@ void mm_print(const MemoryManagement* mm);
  *  - mm: estructura completa
  *  - filename: ruta archivo de comandos
  * 
- *  Abre el archivo, lee línea a línea con fgets,
- *  ignora líneas vacías o que empiezan con '#', llama a parse_command(...)
- *  y luego a mm_execute_command(...). 
+ *  Mapea el archivo con reader_open (sin copias ni límite de largo de línea), recorre las
+ *  líneas ignorando las vacías o que empiezan con '#', llama a parse_command(...)
+ *  y luego a mm_execute_command(...).
  */
 int mm_start(MemoryManagement* mm, const char* filename);
 
@@ -152,10 +289,25 @@ int mm_start(MemoryManagement* mm, const char* filename);
  *  - mm: estado actual
  *  - command: puntero a estructura Command (type, name, size)
  * 
- *  Según command->type invoca a mm_alloc, mm_realloc, mm_free o mm_print.
+ *  Según command->type invoca a mm_alloc, mm_realloc, mm_free, mm_print, mm_stats_print,
+ *  mm_compact_print o mm_purge_print.
  */
 int mm_execute_command(MemoryManagement* mm, const Command* command);
 
+/**
+ * mm_contains:
+ *  - Hay un bloque ocupado con ese nombre (el que encontrarían FREE y REALLOC).
+ */
+bool mm_contains(const MemoryManagement* mm, NameView name);
+
+/**
+ * mm_index_insert / mm_index_remove:
+ *  - Agregan o quitan un bloque libre de los índices de libres (free_lists y free_tree, o tlsf).
+ *    El tamaño y el offset del bloque no deben cambiar mientras esté en los índices.
+ */
+void mm_index_insert(MemoryManagement* mm, Block* block);
+void mm_index_remove(MemoryManagement* mm, Block* block);
+
 /**
  * mm_find_block:
  *  - mm: estado actual
@@ -165,17 +317,43 @@ int mm_execute_command(MemoryManagement* mm, const Command* command);
  *    - FIRST -> mm_find_block_first_fit
  *    - BEST  -> mm_find_block_best_fit
  *    - WORST -> mm_find_block_worst_fit
+ *    - NEXT  -> mm_find_block_next_fit
+ *    - TLSF  -> mm_find_block_tlsf
  */
 Block* mm_find_block(MemoryManagement* mm, size_t requested_size);
 
 /**
- * Algoritmos de búsqueda de bloque:
- *  - mm_find_block_first_fit: primer bloque libre con size >= requested_size.
- *  - mm_find_block_best_fit: bloque libre con size >= requested_size y size mínimo.
- *  - mm_find_block_worst_fit: bloque libre con size >= requested_size y size máximo.
+ * Algoritmos de búsqueda de bloque (consultan los índices de libres, no la lista completa):
+ *  - mm_find_block_first_fit: primer bloque libre con size >= requested_size (free_lists).
+ *  - mm_find_block_best_fit: bloque libre con size >= requested_size y size mínimo (free_tree).
+ *  - mm_find_block_worst_fit: bloque libre con size >= requested_size y size máximo (free_tree).
+ *  - mm_find_block_next_fit: primer bloque libre con size >= requested_size a partir de mm->rover,
+ *    dando una sola vuelta a la lista; deja mm->rover en el bloque encontrado.
+ *  - mm_find_block_tlsf: bloque libre de la primera subclase TLSF que garantiza
+ *    size >= requested_size, en O(1) (tlsf).
  */
 Block* mm_find_block_first_fit(MemoryManagement* mm, size_t requested_size);
 Block* mm_find_block_best_fit(MemoryManagement* mm, size_t requested_size);
 Block* mm_find_block_worst_fit(MemoryManagement* mm, size_t requested_size);
+Block* mm_find_block_next_fit(MemoryManagement* mm, size_t requested_size);
+Block* mm_find_block_tlsf(MemoryManagement* mm, size_t requested_size);
+
+/**
+ * mm_largest_free / mm_stats_print:
+ *  - mm_largest_free: tamaño del mayor bloque libre, consultando los índices de libres (O(log n)
+ *    con el árbol, una subclase con TLSF); 0 si no hay libres.
+ *  - mm_stats_print: imprime mm->stats, el mayor libre y la fragmentación externa (comando
+ *    STATS) sin recorrer la lista de bloques.
+ */
+size_t mm_largest_free(const MemoryManagement* mm);
+void mm_stats_print(const MemoryManagement* mm);
+
+/**
+ * mm_metadata_bytes:
+ *  - Bytes pedidos al sistema para metadata fuera de memory_region: slabs de nodos, índice de
+ *    nombres y tabla de nombres internados. Ninguna de esas estructuras devuelve memoria antes de
+ *    mm_destroy, así que el valor solo crece (el actual es también el pico).
+ */
+size_t mm_metadata_bytes(const MemoryManagement* mm);
 
 #endif  // MEMORY_MANAGEMENT_H
@@ -0,0 +1,193 @@
+#include "name_index.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "name_table.h"
+
+/**************************************************************************************************
+ * name_index_lookup
+ *
+ *  Sondea desde la posición del hash. Devuelve la entrada USED con ese nombre o, si no existe,
+ *  NULL; en ese caso *slot queda en la primera entrada reutilizable (DELETED o EMPTY) del camino.
+ */
+static NameIndexEntry* name_index_lookup(
+  const NameIndex* index, const BlockName* name, uint64_t hash, NameIndexEntry** slot
+) {
+  size_t          mask     = index->capacity - 1;
+  size_t          i        = (size_t) hash & mask;
+  NameIndexEntry* reusable = NULL;
+
+  while (true) {
+    NameIndexEntry* entry = &index->entries[i];
+
+    if (entry->state == NAME_INDEX_EMPTY) {
+      if (slot != NULL) {
+        *slot = reusable != NULL ? reusable : entry;
+      }
+      return NULL;
+    }
+
+    if (entry->state == NAME_INDEX_DELETED) {
+      if (reusable == NULL) {
+        reusable = entry;
+      }
+    } else if (entry->hash == hash && block_name_equal(&entry->blocks->name, name)) {
+      return entry;
+    }
+
+    i = (i + 1) & mask;
+  }
+}
+
+/**************************************************************************************************
+ * name_index_rehash
+ *
+ *  Reconstruye la tabla con 'capacity' entradas, descartando los tombstones.
+ */
+static int name_index_rehash(NameIndex* index, size_t capacity) {
+  NameIndexEntry* entries = calloc(capacity, sizeof(NameIndexEntry));
+  if (entries == NULL) {
+    fprintf(stderr, "name_index_rehash: No se pudo reservar la tabla de %zu entradas.\n", capacity);
+    return EXIT_FAILURE;
+  }
+
+  size_t mask = capacity - 1;
+  for (size_t j = 0; j < index->capacity; j++) {
+    NameIndexEntry* old = &index->entries[j];
+    if (old->state != NAME_INDEX_USED) {
+      continue;
+    }
+    size_t i = (size_t) old->hash & mask;
+    while (entries[i].state != NAME_INDEX_EMPTY) {
+      i = (i + 1) & mask;
+    }
+    entries[i] = *old;
+  }
+
+  free(index->entries);
+  index->entries    = entries;
+  index->capacity   = capacity;
+  index->tombstones = 0;
+  return EXIT_SUCCESS;
+}
+
+/**************************************************************************************************
+ * name_index_init
+ */
+int name_index_init(NameIndex* index) {
+  index->entries = calloc(NAME_INDEX_INITIAL_CAPACITY, sizeof(NameIndexEntry));
+  if (index->entries == NULL) {
+    fprintf(stderr, "name_index_init: No se pudo reservar la tabla de nombres.\n");
+    return EXIT_FAILURE;
+  }
+  index->capacity   = NAME_INDEX_INITIAL_CAPACITY;
+  index->count      = 0;
+  index->tombstones = 0;
+  return EXIT_SUCCESS;
+}
+
+/**************************************************************************************************
+ * name_index_destroy
+ */
+void name_index_destroy(NameIndex* index) {
+  free(index->entries);
+  index->entries    = NULL;
+  index->capacity   = 0;
+  index->count      = 0;
+  index->tombstones = 0;
+}
+
+/**************************************************************************************************
+ * name_index_insert
+ *
+ *  Mantiene la ocupación (usadas + tombstones) por debajo de 3/4. Si hay muchos tombstones basta
+ *  con reconstruir la tabla del mismo tamaño; si no, se duplica.
+ */
+int name_index_insert(NameIndex* index, Block* block) {
+  if ((index->count + index->tombstones + 1) * 4 > index->capacity * 3) {
+    size_t capacity = index->capacity;
+    if ((index->count + 1) * 2 > capacity) {
+      capacity *= 2;
+    }
+    if (name_index_rehash(index, capacity) != EXIT_SUCCESS) {
+      return EXIT_FAILURE;
+    }
+  }
+
+  uint64_t        hash  = block_name_hash(&block->name);
+  NameIndexEntry* slot  = NULL;
+  NameIndexEntry* entry = name_index_lookup(index, &block->name, hash, &slot);
+
+  block->name_prev = NULL;
+
+  if (entry != NULL) {
+    block->name_next         = entry->blocks;
+    entry->blocks->name_prev = block;
+    entry->blocks            = block;
+    return EXIT_SUCCESS;
+  }
+
+  if (slot->state == NAME_INDEX_DELETED) {
+    index->tombstones--;
+  }
+  block->name_next = NULL;
+  slot->state      = NAME_INDEX_USED;
+  slot->hash       = hash;
+  slot->blocks     = block;
+  index->count++;
+  return EXIT_SUCCESS;
+}
+
+/**************************************************************************************************
+ * name_index_remove
+ */
+void name_index_remove(NameIndex* index, Block* block) {
+  if (block->name_prev != NULL) {
+    // No es la cabeza de la cadena: la entrada no cambia.
+    block->name_prev->name_next = block->name_next;
+    if (block->name_next != NULL) {
+      block->name_next->name_prev = block->name_prev;
+    }
+    block->name_next = NULL;
+    block->name_prev = NULL;
+    return;
+  }
+
+  NameIndexEntry* entry = name_index_lookup(index, &block->name, block_name_hash(&block->name), NULL);
+  if (entry == NULL) {
+    return;
+  }
+
+  entry->blocks = block->name_next;
+  if (entry->blocks != NULL) {
+    entry->blocks->name_prev = NULL;
+  } else {
+    entry->state = NAME_INDEX_DELETED;
+    index->count--;
+    index->tombstones++;
+  }
+
+  block->name_next = NULL;
+  block->name_prev = NULL;
+}
+
+/**************************************************************************************************
+ * name_index_find
+ *
+ *  Entre los bloques con el mismo nombre gana el de menor offset, como en el recorrido lineal.
+ */
+Block* name_index_find(const NameIndex* index, const BlockName* name) {
+  NameIndexEntry* entry = name_index_lookup(index, name, block_name_hash(name), NULL);
+  if (entry == NULL) {
+    return NULL;
+  }
+
+  Block* found = entry->blocks;
+  for (Block* current = found->name_next; current != NULL; current = current->name_next) {
+    if (current->offset < found->offset) {
+      found = current;
+    }
+  }
+  return found;
+}
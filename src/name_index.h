@@ -0,0 +1,81 @@
+// name_index.h
+
+#ifndef NAME_INDEX_H
+#define NAME_INDEX_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "block.h"
+
+#define NAME_INDEX_INITIAL_CAPACITY 64  // potencia de dos
+
+typedef enum {
+  NAME_INDEX_EMPTY,
+  NAME_INDEX_USED,
+  NAME_INDEX_DELETED,  // tombstone: la sonda debe seguir de largo
+} NameIndexState;
+
+/**
+ * Una entrada de la tabla:
+ *  - hash: block_name_hash del nombre (se guarda para no recalcularlo al crecer ni comparar
+ *          en vano)
+ *  - blocks: cadena (vía name_next / name_prev) de los bloques ocupados con ese nombre.
+ *            Normalmente tiene un solo bloque; tiene más cuando el nombre se repite
+ *            (ALLOC duplicado o la “fuga” de mm_realloc).
+ */
+typedef struct {
+  NameIndexState state;
+  uint64_t       hash;
+  Block*         blocks;
+} NameIndexEntry;
+
+/**
+ * Tabla hash de direccionamiento abierto (sondeo lineal) de BlockName -> bloques ocupados.
+ * Las claves se comparan por bytes inline o por id internado, nunca con strcmp.
+ *  - capacity: cantidad de entradas (potencia de dos)
+ *  - count: entradas en uso
+ *  - tombstones: entradas borradas que todavía ocupan lugar en las sondas
+ */
+typedef struct {
+  NameIndexEntry* entries;
+  size_t          capacity;
+  size_t          count;
+  size_t          tombstones;
+} NameIndex;
+
+/**
+ * name_index_init:
+ *  - Reserva la tabla con NAME_INDEX_INITIAL_CAPACITY entradas vacías.
+ *  - Devuelve EXIT_FAILURE si no hay memoria.
+ */
+int name_index_init(NameIndex* index);
+
+/**
+ * name_index_destroy:
+ *  - Libera la tabla (no los bloques).
+ */
+void name_index_destroy(NameIndex* index);
+
+/**
+ * name_index_insert:
+ *  - Agrega un bloque ocupado (con nombre no vacío) a la cadena de su nombre.
+ *  - Devuelve EXIT_FAILURE si la tabla necesitaba crecer y no hubo memoria.
+ */
+int name_index_insert(NameIndex* index, Block* block);
+
+/**
+ * name_index_remove:
+ *  - Quita el bloque de la cadena de su nombre; si la cadena queda vacía deja un tombstone.
+ *    Debe llamarse antes de vaciar block->name.
+ */
+void name_index_remove(NameIndex* index, Block* block);
+
+/**
+ * name_index_find:
+ *  - Devuelve el bloque ocupado con ese nombre y menor offset (el mismo que encontraría el
+ *    recorrido de la lista por dirección), o NULL si no hay ninguno.
+ */
+Block* name_index_find(const NameIndex* index, const BlockName* name);
+
+#endif  // NAME_INDEX_H
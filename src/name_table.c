@@ -0,0 +1,232 @@
+#include "name_table.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**************************************************************************************************
+ * name_table_hash
+ *
+ *  FNV-1a de 64 bits sobre 'length' bytes.
+ */
+uint64_t name_table_hash(const void* bytes, size_t length) {
+  const unsigned char* c    = (const unsigned char*) bytes;
+  uint64_t             hash = UINT64_C(14695981039346656037);
+  for (size_t i = 0; i < length; i++) {
+    hash ^= c[i];
+    hash *= UINT64_C(1099511628211);
+  }
+  return hash;
+}
+
+/**************************************************************************************************
+ * name_table_slot
+ *
+ *  Sondea la tabla hash buscando 'name'. Devuelve el índice del slot que lo contiene o, si no
+ *  está, el del primer slot vacío del camino.
+ */
+static size_t name_table_slot(const NameTable* table, const char* name, size_t length) {
+  size_t mask = table->slots_capacity - 1;
+  size_t i    = (size_t) name_table_hash(name, length) & mask;
+
+  while (table->slots[i] != 0) {
+    const char* stored = table->chars + table->offsets[table->slots[i]];
+    if (strncmp(stored, name, length) == 0 && stored[length] == '\0') {
+      return i;
+    }
+    i = (i + 1) & mask;
+  }
+  return i;
+}
+
+/**************************************************************************************************
+ * name_table_grow_slots
+ *
+ *  Duplica la tabla hash y reubica todos los ids.
+ */
+static int name_table_grow_slots(NameTable* table) {
+  size_t    capacity = table->slots_capacity * 2;
+  uint32_t* slots    = calloc(capacity, sizeof(uint32_t));
+  if (slots == NULL) {
+    fprintf(stderr, "name_table_grow_slots: No se pudo reservar %zu slots.\n", capacity);
+    return EXIT_FAILURE;
+  }
+
+  for (uint32_t id = 1; id <= table->count; id++) {
+    const char* stored = table->chars + table->offsets[id];
+    size_t      i      = (size_t) name_table_hash(stored, strlen(stored)) & (capacity - 1);
+    while (slots[i] != 0) {
+      i = (i + 1) & (capacity - 1);
+    }
+    slots[i] = id;
+  }
+
+  free(table->slots);
+  table->slots          = slots;
+  table->slots_capacity = capacity;
+  return EXIT_SUCCESS;
+}
+
+/**************************************************************************************************
+ * name_table_intern
+ *
+ *  Copia 'name' al final de chars y le asigna el próximo id.
+ */
+static int name_table_intern(NameTable* table, const char* name, size_t length, uint32_t* id) {
+  if ((size_t) (table->count + 2) * 4 > table->slots_capacity * 3) {
+    if (name_table_grow_slots(table) != EXIT_SUCCESS) {
+      return EXIT_FAILURE;
+    }
+  }
+
+  if (table->count + 1 >= table->offsets_capacity) {
+    uint32_t capacity = table->offsets_capacity * 2;
+    size_t*  offsets  = realloc(table->offsets, capacity * sizeof(size_t));
+    if (offsets == NULL) {
+      fprintf(stderr, "name_table_intern: No se pudo ampliar la tabla de ids.\n");
+      return EXIT_FAILURE;
+    }
+    table->offsets          = offsets;
+    table->offsets_capacity = capacity;
+  }
+
+  if (table->chars_length + length + 1 > table->chars_capacity) {
+    size_t capacity = table->chars_capacity * 2;
+    while (table->chars_length + length + 1 > capacity) {
+      capacity *= 2;
+    }
+    char* chars = realloc(table->chars, capacity);
+    if (chars == NULL) {
+      fprintf(stderr, "name_table_intern: No se pudo ampliar el almacén de nombres.\n");
+      return EXIT_FAILURE;
+    }
+    table->chars          = chars;
+    table->chars_capacity = capacity;
+  }
+
+  size_t slot = name_table_slot(table, name, length);
+
+  table->count++;
+  table->offsets[table->count] = table->chars_length;
+  memcpy(table->chars + table->chars_length, name, length);
+  table->chars[table->chars_length + length] = '\0';
+  table->chars_length += length + 1;
+  table->slots[slot] = table->count;
+
+  *id = table->count;
+  return EXIT_SUCCESS;
+}
+
+/**************************************************************************************************
+ * name_table_init
+ */
+int name_table_init(NameTable* table) {
+  table->chars            = malloc(NAME_TABLE_INITIAL_CAPACITY * BLOCK_NAME_INLINE);
+  table->offsets          = malloc(NAME_TABLE_INITIAL_CAPACITY * sizeof(size_t));
+  table->slots            = calloc(NAME_TABLE_INITIAL_CAPACITY, sizeof(uint32_t));
+  table->chars_length     = 0;
+  table->chars_capacity   = NAME_TABLE_INITIAL_CAPACITY * BLOCK_NAME_INLINE;
+  table->count            = 0;
+  table->offsets_capacity = NAME_TABLE_INITIAL_CAPACITY;
+  table->slots_capacity   = NAME_TABLE_INITIAL_CAPACITY;
+
+  if (table->chars == NULL || table->offsets == NULL || table->slots == NULL) {
+    fprintf(stderr, "name_table_init: No se pudo reservar la tabla de nombres internados.\n");
+    name_table_destroy(table);
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+
+/**************************************************************************************************
+ * name_table_destroy
+ */
+void name_table_destroy(NameTable* table) {
+  free(table->chars);
+  free(table->offsets);
+  free(table->slots);
+  table->chars   = NULL;
+  table->offsets = NULL;
+  table->slots   = NULL;
+  table->count   = 0;
+}
+
+/**************************************************************************************************
+ * name_table_make
+ */
+int name_table_make(NameTable* table, NameView name, BlockName* out) {
+  block_name_clear(out);
+  if (name.length > 0 && name.length < BLOCK_NAME_INLINE) {
+    memcpy(out->inline_name, name.data, name.length);
+    return EXIT_SUCCESS;
+  }
+
+  size_t slot = name_table_slot(table, name.data, name.length);
+  if (table->slots[slot] != 0) {
+    out->interned.id = table->slots[slot];
+    return EXIT_SUCCESS;
+  }
+
+  return name_table_intern(table, name.data, name.length, &out->interned.id);
+}
+
+/**************************************************************************************************
+ * name_table_find
+ */
+bool name_table_find(const NameTable* table, NameView name, BlockName* out) {
+  block_name_clear(out);
+  if (name.length > 0 && name.length < BLOCK_NAME_INLINE) {
+    memcpy(out->inline_name, name.data, name.length);
+    return true;
+  }
+
+  size_t slot = name_table_slot(table, name.data, name.length);
+  if (table->slots[slot] == 0) {
+    return false;
+  }
+  out->interned.id = table->slots[slot];
+  return true;
+}
+
+/**************************************************************************************************
+ * name_table_str
+ *
+ *  Un nombre inline de BLOCK_NAME_INLINE - 1 caracteres sigue terminado en '\0' porque el último
+ *  byte del arreglo nunca se usa.
+ */
+const char* name_table_str(const NameTable* table, const BlockName* name) {
+  if (name->inline_name[0] != '\0') {
+    return name->inline_name;
+  }
+  if (name->interned.id == 0) {
+    return "";
+  }
+  return table->chars + table->offsets[name->interned.id];
+}
+
+/**************************************************************************************************
+ * block_name_clear / block_name_is_empty / block_name_equal / block_name_hash
+ *
+ *  Un nombre inline se compara por sus bytes (el relleno es '\0') y uno internado por su id.
+ */
+void block_name_clear(BlockName* name) {
+  memset(name, 0, sizeof(BlockName));
+}
+
+bool block_name_is_empty(const BlockName* name) {
+  return name->inline_name[0] == '\0' && name->interned.id == 0;
+}
+
+bool block_name_equal(const BlockName* a, const BlockName* b) {
+  if (a->inline_name[0] != '\0' || b->inline_name[0] != '\0') {
+    return memcmp(a->inline_name, b->inline_name, BLOCK_NAME_INLINE) == 0;
+  }
+  return a->interned.id == b->interned.id;
+}
+
+uint64_t block_name_hash(const BlockName* name) {
+  if (name->inline_name[0] != '\0') {
+    return name_table_hash(name->inline_name, BLOCK_NAME_INLINE);
+  }
+  return name_table_hash(&name->interned.id, sizeof(name->interned.id));
+}
@@ -0,0 +1,78 @@
+// name_table.h
+
+#ifndef NAME_TABLE_H
+#define NAME_TABLE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "block.h"
+#include "name_view.h"
+
+#define NAME_TABLE_INITIAL_CAPACITY 64  // potencia de dos
+
+/**
+ * Tabla de internado de nombres largos (los que no entran inline en BlockName):
+ *  - chars: todos los nombres internados, uno detrás de otro y terminados en '\0'
+ *  - offsets: offsets[id] es la posición del nombre 'id' dentro de chars (el id 0 no se usa)
+ *  - slots: tabla hash (sondeo lineal) de ids; 0 = vacío
+ *
+ * Los nombres internados viven hasta name_table_destroy: cada nombre largo distinto cuesta una
+ * sola copia, sin importar cuántos ALLOC lo usen.
+ */
+typedef struct {
+  char*     chars;
+  size_t    chars_length;
+  size_t    chars_capacity;
+  size_t*   offsets;
+  uint32_t  count;           // ids entregados (el próximo id es count + 1)
+  uint32_t  offsets_capacity;
+  uint32_t* slots;
+  size_t    slots_capacity;
+} NameTable;
+
+/**
+ * name_table_init / name_table_destroy:
+ *  - Reserva / libera la tabla. name_table_init devuelve EXIT_FAILURE si no hay memoria.
+ */
+int name_table_init(NameTable* table);
+void name_table_destroy(NameTable* table);
+
+/**
+ * name_table_make:
+ *  - Arma el BlockName de 'name': inline si es corto, internándolo si es largo.
+ *  - Devuelve EXIT_FAILURE si había que internarlo y no hubo memoria.
+ */
+int name_table_make(NameTable* table, NameView name, BlockName* out);
+
+/**
+ * name_table_find:
+ *  - Como name_table_make pero sin internar: devuelve false si 'name' es largo y nunca fue
+ *    internado (y por lo tanto ningún bloque puede tenerlo).
+ */
+bool name_table_find(const NameTable* table, NameView name, BlockName* out);
+
+/**
+ * name_table_str:
+ *  - Devuelve el texto del nombre (inline o internado). Para un nombre vacío devuelve "".
+ */
+const char* name_table_str(const NameTable* table, const BlockName* name);
+
+/**
+ * name_table_hash:
+ *  - Hash (FNV-1a de 64 bits) de 'length' bytes; el mismo que usa la tabla para sus slots.
+ */
+uint64_t name_table_hash(const void* bytes, size_t length);
+
+/**
+ * block_name_clear / block_name_is_empty / block_name_equal / block_name_hash:
+ *  - Operaciones sobre BlockName que no necesitan la tabla: comparan bytes inline o ids,
+ *    nunca cadenas.
+ */
+void block_name_clear(BlockName* name);
+bool block_name_is_empty(const BlockName* name);
+bool block_name_equal(const BlockName* a, const BlockName* b);
+uint64_t block_name_hash(const BlockName* name);
+
+#endif  // NAME_TABLE_H
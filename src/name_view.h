@@ -0,0 +1,18 @@
+// name_view.h
+
+#ifndef NAME_VIEW_H
+#define NAME_VIEW_H
+
+#include <stddef.h>
+
+/**
+ * Nombre prestado: puntero y largo dentro de un texto ajeno (por ejemplo, el archivo de comandos
+ * mapeado en memoria). No está terminado en '\0' y no es dueño de nada; vale mientras viva el
+ * texto del que sale. Para imprimirlo: printf("%.*s", (int) name.length, name.data).
+ */
+typedef struct {
+  const char* data;
+  size_t      length;
+} NameView;
+
+#endif  // NAME_VIEW_H
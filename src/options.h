@@ -0,0 +1,73 @@
+// options.h
+
+#ifndef OPTIONS_H
+#define OPTIONS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * Cuándo se devuelven al SO las páginas de los bloques libres grandes (ver purge.h):
+ *  - NONE: solo con el comando PURGE
+ *  - EAGER: en cada FREE (y COMPACT) que deja un bloque libre de al menos purge_threshold bytes
+ *  - DECAY: en una pasada sobre todos los libres cada purge_period comandos
+ */
+typedef enum {
+  PURGE_NONE,
+  PURGE_EAGER,
+  PURGE_DECAY
+} PurgeMode;
+
+/**
+ * Cuándo se unen los bloques libres contiguos (ver mm_coalesce):
+ *  - EAGER: en cada FREE (mm_free_join)
+ *  - LAZY: FREE solo marca el bloque libre; una pasada lineal los une cuando un ALLOC no
+ *          encuentra bloque o cada coalesce_period FREE
+ */
+typedef enum {
+  COALESCE_EAGER,
+  COALESCE_LAZY
+} CoalesceMode;
+
+/**
+ * Opciones de ejecución que no son la estrategia de ubicación (argumentos extra de la línea de
+ * comandos, ver parse_option). Un MMOptions en cero son los valores por defecto.
+ *  - tags: metadata en banda (boundary tags dentro de memory_region) en lugar de nodos Block
+ *  - arenas: con N > 0 la región se reparte en N arenas y los comandos se ejecutan en un hilo
+ *            por cada prefijo "T<n>" de la traza (ver arena.h)
+ *  - pipeline: una traza de texto se parsea en un hilo y se ejecuta en otro (ver pipeline.h)
+ *  - compact_retry: si un ALLOC no encuentra bloque pero los bytes libres alcanzan, compacta la
+ *                   región (ver compact.h) y lo reintenta
+ *  - realloc_move: un REALLOC que no puede crecer sobre su vecino siguiente se une también con el
+ *                  anterior o se muda a otro bloque y libera el viejo, en lugar de “simular fuga”
+ *  - region_size: bytes de la región con --size=BYTES[K|M|G|T] (0: el tamaño por defecto)
+ *  - hugepages: la región se mapea con páginas grandes (ver region.h)
+ *  - grow / grow_limit: con --grow[=MAX] el heap agrega segmentos cuando un ALLOC no encuentra
+ *    bloque, hasta MAX bytes en total (0: SEGMENT_DEFAULT_LIMIT; ver segment.h)
+ *  - cache / cache_count: con --cache[=N] los FREE de bloques chicos van a una caché LIFO por
+ *    tamaño exacto de hasta N bloques cada una (0: BLOCK_CACHE_DEFAULT_COUNT; ver block_cache.h)
+ *  - coalesce / coalesce_period: --coalesce=eager o --coalesce=lazy[:N] (N = 0: solo cuando un
+ *    ALLOC no encuentra bloque)
+ *  - purge / purge_threshold / purge_period: --purge=eager[:MIN] o --purge=decay:N[:MIN]; MIN
+ *    es el bloque libre mínimo para PURGE y las dos políticas (0: PURGE_DEFAULT_MIN)
+ */
+typedef struct {
+  bool         tags;
+  size_t       arenas;
+  bool         pipeline;
+  bool         compact_retry;
+  bool         realloc_move;
+  size_t       region_size;
+  bool         hugepages;
+  bool         grow;
+  size_t       grow_limit;
+  bool         cache;
+  size_t       cache_count;
+  CoalesceMode coalesce;
+  size_t       coalesce_period;
+  PurgeMode    purge;
+  size_t       purge_threshold;
+  size_t       purge_period;
+} MMOptions;
+
+#endif  // OPTIONS_H
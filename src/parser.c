@@ -2,6 +2,9 @@
 
 #include "parser.h"
 
+#include <ctype.h>
+#include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -22,92 +25,388 @@ int parse_strategy(const char* arg, StrategyType* strategy) {
     return EXIT_SUCCESS;
   }
 
+  if (strcmp(arg, "next") == 0) {
+    *strategy = STRATEGY_NEXT;
+    return EXIT_SUCCESS;
+  }
+
+  if (strcmp(arg, "buddy") == 0) {
+    *strategy = STRATEGY_BUDDY;
+    return EXIT_SUCCESS;
+  }
+
+  if (strcmp(arg, "tlsf") == 0) {
+    *strategy = STRATEGY_TLSF;
+    return EXIT_SUCCESS;
+  }
+
   fprintf(stderr, "parse_strategy: Unknown strategy: %s.\n", arg);
 
   return EXIT_FAILURE;
 }
 
-int parse_command(char* buffer, Command* command) {
+const char* strategy_name(StrategyType strategy) {
+  switch (strategy) {
+    case STRATEGY_BEST:
+      return "best";
+    case STRATEGY_FIRST:
+      return "first";
+    case STRATEGY_WORST:
+      return "worst";
+    case STRATEGY_NEXT:
+      return "next";
+    case STRATEGY_BUDDY:
+      return "buddy";
+    case STRATEGY_TLSF:
+      return "tlsf";
+    default:
+      return "unknown";
+  }
+}
+
+/**
+ * parse_bytes: decimal bytes with an optional K, M, G or T suffix (powers of 1024).
+ * Returns 0 when the text is not a size or does not fit in a size_t.
+ */
+static size_t parse_bytes(const char* text) {
+  char*              end;
+  unsigned long long value = strtoull(text, &end, 10);
+  if (end == text || !isdigit((unsigned char) *text)) {
+    return 0;
+  }
+
+  const char* suffixes = "KMGT";
+  unsigned    shift    = 0;
+  if (*end != '\0' && strchr(suffixes, *end) != NULL) {
+    shift = 10 * (unsigned) (strchr(suffixes, *end) - suffixes + 1);
+    end++;
+  }
+  if (*end != '\0' || value > (SIZE_MAX >> shift)) {
+    return 0;
+  }
+  return (size_t) value << shift;
+}
+
+/**
+ * parse_purge: "eager[:MIN]" or "decay:N[:MIN]" (the text after --purge=).
+ */
+static int parse_purge(const char* spec, MMOptions* options) {
+  const char* colon  = strchr(spec, ':');
+  size_t      length = colon != NULL ? (size_t) (colon - spec) : strlen(spec);
+  const char* rest   = colon != NULL ? colon + 1 : NULL;
+
+  if (length == 5 && memcmp(spec, "eager", 5) == 0) {
+    options->purge = PURGE_EAGER;
+  } else if (length == 5 && memcmp(spec, "decay", 5) == 0 && rest != NULL &&
+             isdigit((unsigned char) *rest)) {
+    char*         end;
+    unsigned long period = strtoul(rest, &end, 10);
+    if (period == 0 || (*end != '\0' && *end != ':')) {
+      return EXIT_FAILURE;
+    }
+    options->purge        = PURGE_DECAY;
+    options->purge_period = period;
+    rest                  = *end == ':' ? end + 1 : NULL;
+  } else {
+    return EXIT_FAILURE;
+  }
+
+  if (rest != NULL) {
+    options->purge_threshold = parse_bytes(rest);
+    if (options->purge_threshold == 0) {
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
+
+/**
+ * parse_coalesce: "eager" or "lazy[:N]" (the text after --coalesce=).
+ */
+static int parse_coalesce(const char* spec, MMOptions* options) {
+  if (strcmp(spec, "eager") == 0) {
+    options->coalesce        = COALESCE_EAGER;
+    options->coalesce_period = 0;
+    return EXIT_SUCCESS;
+  }
+  if (strncmp(spec, "lazy", 4) != 0 || (spec[4] != '\0' && spec[4] != ':')) {
+    return EXIT_FAILURE;
+  }
+
+  size_t period = 0;
+  if (spec[4] == ':') {
+    char* end;
+    period = strtoul(spec + 5, &end, 10);
+    if (!isdigit((unsigned char) spec[5]) || *end != '\0' || period == 0) {
+      return EXIT_FAILURE;
+    }
+  }
+  options->coalesce        = COALESCE_LAZY;
+  options->coalesce_period = period;
+  return EXIT_SUCCESS;
+}
+
+int parse_option(const char* arg, MMOptions* options) {
+  if (strcmp(arg, "--tags") == 0) {
+    options->tags = true;
+    return EXIT_SUCCESS;
+  }
+
+  if (strcmp(arg, "--pipeline") == 0) {
+    options->pipeline = true;
+    return EXIT_SUCCESS;
+  }
+
+  if (strcmp(arg, "--compact-retry") == 0) {
+    options->compact_retry = true;
+    return EXIT_SUCCESS;
+  }
+
+  if (strcmp(arg, "--realloc=move") == 0 || strcmp(arg, "--realloc=leak") == 0) {
+    options->realloc_move = strcmp(arg + 10, "move") == 0;
+    return EXIT_SUCCESS;
+  }
+
+  if (strcmp(arg, "--hugepages") == 0) {
+    options->hugepages = true;
+    return EXIT_SUCCESS;
+  }
+
+  if (strncmp(arg, "--size=", 7) == 0) {
+    options->region_size = parse_bytes(arg + 7);
+    if (options->region_size == 0) {
+      fprintf(stderr, "parse_option: Bad region size: %s.\n", arg);
+      return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+  }
+
+  if (strcmp(arg, "--grow") == 0 || strncmp(arg, "--grow=", 7) == 0) {
+    options->grow       = true;
+    options->grow_limit = arg[6] == '=' ? parse_bytes(arg + 7) : 0;
+    if (arg[6] == '=' && options->grow_limit == 0) {
+      fprintf(stderr, "parse_option: Bad growth limit: %s.\n", arg);
+      return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+  }
+
+  if (strcmp(arg, "--cache") == 0 || strncmp(arg, "--cache=", 8) == 0) {
+    char* end = NULL;
+    options->cache       = true;
+    options->cache_count = arg[7] == '=' ? strtoul(arg + 8, &end, 10) : 0;
+    if (arg[7] == '=' && (options->cache_count == 0 || *end != '\0')) {
+      fprintf(stderr, "parse_option: Bad cache size: %s.\n", arg);
+      return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+  }
+
+  if (strncmp(arg, "--coalesce=", 11) == 0) {
+    if (parse_coalesce(arg + 11, options) != EXIT_SUCCESS) {
+      fprintf(stderr, "parse_option: Bad coalesce mode: %s.\n", arg);
+      return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+  }
+
+  if (strncmp(arg, "--purge=", 8) == 0) {
+    if (parse_purge(arg + 8, options) != EXIT_SUCCESS) {
+      fprintf(stderr, "parse_option: Bad purge policy: %s.\n", arg);
+      return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+  }
+
+  if (strncmp(arg, "--arenas=", 9) == 0) {
+    char* end;
+    unsigned long arenas = strtoul(arg + 9, &end, 10);
+    if (*end != '\0' || arenas == 0) {
+      fprintf(stderr, "parse_option: Bad arena count: %s.\n", arg);
+      return EXIT_FAILURE;
+    }
+    options->arenas = arenas;
+    return EXIT_SUCCESS;
+  }
+
+  fprintf(stderr, "parse_option: Unknown option: %s.\n", arg);
+
+  return EXIT_FAILURE;
+}
+
+/**
+ * parse_token: skips blanks and leaves in 'token' the next word of [*cursor, end), advancing
+ * *cursor past it. Returns false when the line has no more words.
+ */
+static bool parse_token(const char** cursor, const char* end, NameView* token) {
+  const char* c = *cursor;
+  while (c < end && (*c == ' ' || *c == '\t' || *c == '\r')) {
+    c++;
+  }
+  if (c == end) {
+    *cursor = c;
+    return false;
+  }
+
+  token->data = c;
+  while (c < end && *c != ' ' && *c != '\t' && *c != '\r') {
+    c++;
+  }
+  token->length = (size_t) (c - token->data);
+  *cursor = c;
+  return true;
+}
+
+/**
+ * parse_number: leading decimal digits of 'token' (like strtoul, stops at the first non-digit
+ * and saturates on overflow). Sets *all_digits when the whole token was consumed.
+ */
+static size_t parse_number(NameView token, bool* all_digits) {
+  size_t value = 0;
+  size_t i = 0;
+  for (; i < token.length && isdigit((unsigned char) token.data[i]); i++) {
+    size_t digit = (size_t) (token.data[i] - '0');
+    value = value > (SIZE_MAX - digit) / 10 ? SIZE_MAX : value * 10 + digit;
+  }
+  if (all_digits != NULL) {
+    *all_digits = i == token.length && i > 0;
+  }
+  return value;
+}
+
+int parse_command(const char* line, size_t length, Command* command) {
+  const char* cursor = line;
+  const char* end = line + length;
+
   command->size = 0;
-  command->name = NULL;
+  command->name.data = NULL;
+  command->name.length = 0;
+  command->thread_id = 0;
 
-  char* arg1 = strtok(buffer, " \n");
-  if (arg1 == NULL) {
+  NameView arg1;
+  if (!parse_token(&cursor, end, &arg1)) {
     fprintf(stderr, "parse_command: No command.\n");
     return EXIT_FAILURE;
   }
 
+  // Optional thread prefix: "T<n> ALLOC a 10"
+  if (arg1.length > 1 && arg1.data[0] == 'T' && isdigit((unsigned char) arg1.data[1])) {
+    bool all_digits;
+    NameView digits = {arg1.data + 1, arg1.length - 1};
+    size_t thread_id = parse_number(digits, &all_digits);
+    if (!all_digits || thread_id >= COMMAND_MAX_THREADS) {
+      fprintf(stderr, "parse_command: Bad thread id: %.*s.\n", (int) arg1.length, arg1.data);
+      return EXIT_FAILURE;
+    }
+    command->thread_id = (unsigned) thread_id;
+
+    if (!parse_token(&cursor, end, &arg1)) {
+      fprintf(stderr, "parse_command: No command.\n");
+      return EXIT_FAILURE;
+    }
+  }
+
   CommandType type;
-  if (parse_command_type(arg1, &type) != EXIT_SUCCESS) {
+  if (parse_command_type(arg1.data, arg1.length, &type) != EXIT_SUCCESS) {
     return EXIT_FAILURE;
   }
 
   command->type = type;
 
   if (command->type == CMD_ALLOC || command->type == CMD_REALLOC) {
-    char* arg2 = strtok(NULL, " \n");
-    char* arg3 = strtok(NULL, " \n");
-
-    if (arg2 == NULL || arg3 == NULL) {
+    NameView arg3;
+    if (!parse_token(&cursor, end, &command->name) || !parse_token(&cursor, end, &arg3)) {
       fprintf(stderr, "parse_command: Bad command format.\n");
       return EXIT_FAILURE;
     }
 
-    command->size = strtoul(arg3, NULL, 10);
-    command->name = strdup(arg2);
-    if (command->name == NULL) {
-      fprintf(stderr, "parse_command: Can't copy name: %s\n", arg2);
-      return EXIT_FAILURE;
-    }
-
+    command->size = parse_number(arg3, NULL);
     return EXIT_SUCCESS;
   }
 
   if (command->type == CMD_FREE) {
-    char* arg2 = strtok(NULL, " \n");
-    if (arg2 == NULL) {
+    if (!parse_token(&cursor, end, &command->name)) {
       fprintf(stderr, "parse_command: Bad command format.\n");
       return EXIT_FAILURE;
     }
 
-    command->name = strdup(arg2);
-    if (command->name == NULL) {
-      fprintf(stderr, "parse_command: Can't copy name: %s.\n", arg2);
-      return EXIT_FAILURE;
-    }
+    return EXIT_SUCCESS;
+  }
 
+  if (command->type == CMD_PRINT || command->type == CMD_STATS || command->type == CMD_PURGE) {
     return EXIT_SUCCESS;
   }
 
-  if (command->type == CMD_PRINT) {
+  // COMPACT [K]: optional byte budget
+  if (command->type == CMD_COMPACT) {
+    NameView budget;
+    if (parse_token(&cursor, end, &budget)) {
+      bool all_digits;
+      command->size = parse_number(budget, &all_digits);
+      if (!all_digits) {
+        fprintf(stderr, "parse_command: Bad compact budget: %.*s.\n", (int) budget.length,
+                budget.data);
+        return EXIT_FAILURE;
+      }
+    }
     return EXIT_SUCCESS;
   }
 
   return EXIT_FAILURE;
 }
 
-int parse_command_type(const char* arg, CommandType* type) {
-  if (strcmp(arg, "ALLOC") == 0) {
+/**
+ * parse_word_is: 'arg' is a word inside the line (not NUL-terminated); lengths are compared
+ * first so most mismatches never look at the bytes.
+ */
+static bool parse_word_is(const char* arg, size_t length, const char* word, size_t word_length) {
+  return length == word_length && memcmp(arg, word, length) == 0;
+}
+
+int parse_command_type(const char* arg, size_t length, CommandType* type) {
+  if (parse_word_is(arg, length, "ALLOC", 5)) {
     *type = CMD_ALLOC;
     return EXIT_SUCCESS;
   }
 
-  if (strcmp(arg, "REALLOC") == 0) {
+  if (parse_word_is(arg, length, "REALLOC", 7)) {
     *type = CMD_REALLOC;
     return EXIT_SUCCESS;
   }
 
-  if (strcmp(arg, "FREE") == 0) {
+  if (parse_word_is(arg, length, "FREE", 4)) {
     *type = CMD_FREE;
     return EXIT_SUCCESS;
   }
 
-  if (strcmp(arg, "PRINT") == 0) {
+  if (parse_word_is(arg, length, "PRINT", 5)) {
     *type = CMD_PRINT;
     return EXIT_SUCCESS;
   }
 
-  fprintf(stderr, "parse_command_type: Unknown command type: %s.\n", arg);
+  if (parse_word_is(arg, length, "STATS", 5)) {
+    *type = CMD_STATS;
+    return EXIT_SUCCESS;
+  }
+
+  if (parse_word_is(arg, length, "COMPACT", 7)) {
+    *type = CMD_COMPACT;
+    return EXIT_SUCCESS;
+  }
+
+  if (parse_word_is(arg, length, "PURGE", 5)) {
+    *type = CMD_PURGE;
+    return EXIT_SUCCESS;
+  }
+
+  fprintf(stderr, "parse_command_type: Unknown command type: %.*s.\n", (int) length, arg);
 
   return EXIT_FAILURE;
 }
+
+/**
+ * command_has_name: ALLOC, REALLOC and FREE carry a name; the rest act on the whole region.
+ */
+bool command_has_name(CommandType type) {
+  return type == CMD_ALLOC || type == CMD_REALLOC || type == CMD_FREE;
+}
@@ -3,13 +3,23 @@
 #ifndef PARSER_H
 #define PARSER_H
 
+#include <stdbool.h>
+#include <stddef.h>
+
 #include "command.h"
+#include "options.h"
 #include "strategy.h"
 
 int parse_strategy(const char* arg, StrategyType* strategy);
 
-int parse_command(char* arg, Command* command);
+const char* strategy_name(StrategyType strategy);
+
+int parse_option(const char* arg, MMOptions* options);
+
+int parse_command(const char* line, size_t length, Command* command);
+
+int parse_command_type(const char* arg, size_t length, CommandType* type);
 
-int parse_command_type(const char* arg, CommandType* type);
+bool command_has_name(CommandType type);
 
 #endif  // PARSER_H
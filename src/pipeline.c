@@ -0,0 +1,148 @@
+#include "pipeline.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "parser.h"
+#include "reader.h"
+
+#define PIPELINE_SPIN 64  // vueltas de espera activa antes de ceder el procesador
+
+/**
+ * Estado del hilo productor: parsea 'reader' hacia 'ring'.
+ */
+typedef struct {
+  CommandRing* ring;
+  Reader*      reader;
+} PipelineProducer;
+
+/**************************************************************************************************
+ * pipeline_wait
+ *
+ *  Espera un poco sin bloquear: primero gira, después cede el procesador (con un solo núcleo,
+ *  girar solo demora al otro hilo).
+ */
+static void pipeline_wait(unsigned* spins) {
+  if (++*spins < PIPELINE_SPIN) {
+    return;
+  }
+  *spins = 0;
+  sched_yield();
+}
+
+/**************************************************************************************************
+ * pipeline_produce
+ *
+ *  Cada comando se escribe en su lugar y recién después se publica con un store-release de
+ *  tail; el consumidor lo lee con acquire, así que ve el comando completo. head se relee solo
+ *  cuando la copia local dice que la cola está llena.
+ */
+static void* pipeline_produce(void* arg) {
+  PipelineProducer* producer = arg;
+  CommandRing*      ring     = producer->ring;
+  size_t            tail     = 0;
+  size_t            head     = 0;
+
+  const char* line;
+  size_t      length;
+  while (!atomic_load_explicit(&ring->stop, memory_order_relaxed) &&
+         reader_next_line(producer->reader, &line, &length)) {
+    Command* command = &ring->commands[tail & (PIPELINE_RING_CAPACITY - 1)];
+
+    unsigned spins = 0;
+    while (tail - head == PIPELINE_RING_CAPACITY) {
+      if (atomic_load_explicit(&ring->stop, memory_order_relaxed)) {
+        return NULL;  // el consumidor ya no lee la cola
+      }
+      pipeline_wait(&spins);
+      head = atomic_load_explicit(&ring->head, memory_order_acquire);
+    }
+
+    if (parse_command(line, length, command) != EXIT_SUCCESS) {
+      fprintf(stderr, "pipeline_start: Error al parsear comando: %.*s\n", (int) length, line);
+      atomic_store_explicit(&ring->failed, true, memory_order_relaxed);
+      break;
+    }
+
+    atomic_store_explicit(&ring->tail, ++tail, memory_order_release);
+  }
+
+  atomic_store_explicit(&ring->done, true, memory_order_release);
+  return NULL;
+}
+
+/**************************************************************************************************
+ * pipeline_start
+ *
+ *  1) Mapea el archivo y lanza el productor.
+ *  2) Consume en orden: con la cola vacía, si el productor terminó (done se lee antes que tail,
+ *     así que un tail viejo no se confunde con el final) sale; si no, espera.
+ *  3) Si un comando falla, avisa al productor con stop y espera a que termine.
+ *  4) El mapeo se libera recién cuando los dos hilos terminaron: los nombres apuntan a él.
+ */
+int pipeline_start(MemoryManagement* mm, const char* filename) {
+  Reader reader;
+  if (reader_open(&reader, filename) != EXIT_SUCCESS) {
+    fprintf(stderr, "pipeline_start: No se pudo abrir el archivo: %s\n", filename);
+    return EXIT_FAILURE;
+  }
+
+  CommandRing* ring = aligned_alloc(PIPELINE_CACHE_LINE, sizeof(CommandRing));
+  if (ring == NULL) {
+    fprintf(stderr, "pipeline_start: No se pudo reservar la cola de comandos.\n");
+    reader_close(&reader);
+    return EXIT_FAILURE;
+  }
+  atomic_init(&ring->head, 0);
+  atomic_init(&ring->tail, 0);
+  atomic_init(&ring->done, false);
+  atomic_init(&ring->failed, false);
+  atomic_init(&ring->stop, false);
+
+  PipelineProducer producer = {ring, &reader};
+  pthread_t        thread;
+  if (pthread_create(&thread, NULL, pipeline_produce, &producer) != 0) {
+    fprintf(stderr, "pipeline_start: No se pudo crear el hilo productor.\n");
+    free(ring);
+    reader_close(&reader);
+    return EXIT_FAILURE;
+  }
+
+  int      result = EXIT_SUCCESS;
+  size_t   head   = 0;
+  size_t   tail   = 0;
+  unsigned spins  = 0;
+  for (;;) {
+    if (head == tail) {
+      bool done = atomic_load_explicit(&ring->done, memory_order_acquire);
+      tail      = atomic_load_explicit(&ring->tail, memory_order_acquire);
+      if (head == tail) {
+        if (done) {
+          break;
+        }
+        pipeline_wait(&spins);
+        continue;
+      }
+    }
+
+    const Command* command = &ring->commands[head & (PIPELINE_RING_CAPACITY - 1)];
+    if (mm_execute_command(mm, command) != EXIT_SUCCESS) {
+      fprintf(stderr, "pipeline_start: Error al ejecutar el comando %zu.\n", head);
+      atomic_store_explicit(&ring->stop, true, memory_order_relaxed);
+      result = EXIT_FAILURE;
+      break;
+    }
+    atomic_store_explicit(&ring->head, ++head, memory_order_release);
+  }
+
+  pthread_join(thread, NULL);
+  if (atomic_load_explicit(&ring->failed, memory_order_relaxed)) {
+    result = EXIT_FAILURE;
+  }
+
+  free(ring);
+  reader_close(&reader);
+  return result;
+}
@@ -0,0 +1,47 @@
+// pipeline.h
+
+#ifndef PIPELINE_H
+#define PIPELINE_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "command.h"
+#include "memory_management.h"
+
+#define PIPELINE_RING_CAPACITY 4096  // potencia de dos
+#define PIPELINE_CACHE_LINE    64
+
+/**
+ * Cola acotada de un productor y un consumidor (SPSC) de Command, sin locks:
+ *  - commands: los comandos ya parseados; el NameView de cada uno apunta al archivo mapeado, así
+ *    que pasar un comando de un hilo al otro no copia el nombre
+ *  - head: próximo a ejecutar (lo escribe solo el consumidor)
+ *  - tail: próximo lugar libre (lo escribe solo el productor)
+ *  - done: el productor no va a agregar más; failed: porque una línea no parseó
+ *  - stop: el consumidor falló y el productor debe dejar de parsear
+ *
+ * head y tail van en líneas de caché distintas para que los dos hilos no se las disputen.
+ */
+typedef struct {
+  Command commands[PIPELINE_RING_CAPACITY];
+  _Alignas(PIPELINE_CACHE_LINE) atomic_size_t head;
+  _Alignas(PIPELINE_CACHE_LINE) atomic_size_t tail;
+  _Alignas(PIPELINE_CACHE_LINE) atomic_bool done;
+  atomic_bool failed;
+  atomic_bool stop;
+} CommandRing;
+
+/**
+ * pipeline_start:
+ *  - Como mm_start, pero en dos etapas: un hilo productor mapea 'filename' y parsea cada línea
+ *    hacia un CommandRing, y el hilo que llama ejecuta los comandos en orden con
+ *    mm_execute_command. Mientras uno parsea el otro asigna, así que el tiempo total tiende al
+ *    de la etapa más lenta y no a la suma.
+ *  - Se detiene en el primer comando que no parsea o no se ejecuta; los anteriores ya quedaron
+ *    ejecutados, igual que con mm_start.
+ */
+int pipeline_start(MemoryManagement* mm, const char* filename);
+
+#endif  // PIPELINE_H
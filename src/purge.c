@@ -0,0 +1,182 @@
+#include "purge.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "region.h"
+
+/**************************************************************************************************
+ * purge_page_size
+ */
+static size_t purge_page_size(const MemoryManagement* mm) {
+  if (mm->options.hugepages) {
+    return REGION_HUGE_PAGE;
+  }
+  long page = sysconf(_SC_PAGESIZE);
+  return page > 0 ? (size_t) page : 4096;
+}
+
+/**************************************************************************************************
+ * purge_block
+ *
+ *  Las páginas se alinean sobre la dirección real (memory_region + offset): con arenas la región
+ *  de cada una empieza donde termina la anterior, no en un borde de página. Solo se devuelven las
+ *  páginas enteras del bloque que tocan su tramo sucio, así una página ya devuelta no se vuelve a
+ *  contar. Un bloque devuelto queda limpio; uno sin ninguna de esas páginas sigue sucio (lo sucio
+ *  está en páginas compartidas con sus vecinos).
+ */
+static size_t purge_block(MemoryManagement* mm, Block* block) {
+  uintptr_t page  = (uintptr_t) purge_page_size(mm);
+  uintptr_t base  = (uintptr_t) mm->memory_region;
+  uintptr_t first = (base + block->offset + page - 1) & ~(page - 1);
+  uintptr_t last  = (base + block->offset + block->size) & ~(page - 1);
+  uintptr_t low   = (base + block->dirty.start) & ~(page - 1);
+  uintptr_t high  = (base + block->dirty.end + page - 1) & ~(page - 1);
+  first           = low > first ? low : first;
+  last            = high < last ? high : last;
+  if (last <= first || madvise((void*) first, (size_t) (last - first), MADV_DONTNEED) != 0) {
+    return 0;
+  }
+
+  block->dirty.since = 0;
+  mm->stats.purges++;
+  mm->stats.purged_bytes += (size_t) (last - first);
+  return (size_t) (last - first);
+}
+
+/**************************************************************************************************
+ * mm_purge_touch
+ */
+void mm_purge_touch(MemoryManagement* mm, Block* block, size_t start, size_t end) {
+  if (start >= end) {
+    return;
+  }
+  if (block->dirty.since == 0) {
+    block->dirty = (BlockDirty) {mm->purge_clock, start, end};
+    return;
+  }
+  block->dirty.start = start < block->dirty.start ? start : block->dirty.start;
+  block->dirty.end   = end > block->dirty.end ? end : block->dirty.end;
+}
+
+/**************************************************************************************************
+ * mm_purge_absorb
+ *
+ *  La marca más antigua gana: la unión lleva sucia al menos desde entonces.
+ */
+void mm_purge_absorb(Block* into, const Block* from) {
+  if (from->dirty.since == 0) {
+    return;
+  }
+  if (into->dirty.since == 0) {
+    into->dirty = from->dirty;
+    return;
+  }
+  into->dirty.since = from->dirty.since < into->dirty.since ? from->dirty.since : into->dirty.since;
+  into->dirty.start = from->dirty.start < into->dirty.start ? from->dirty.start : into->dirty.start;
+  into->dirty.end   = from->dirty.end > into->dirty.end ? from->dirty.end : into->dirty.end;
+}
+
+/**************************************************************************************************
+ * mm_purge_inherit
+ */
+void mm_purge_inherit(Block* rest, const BlockDirty* from) {
+  size_t start = rest->offset > from->start ? rest->offset : from->start;
+  size_t end   = rest->offset + rest->size < from->end ? rest->offset + rest->size : from->end;
+  rest->dirty  = (BlockDirty) {from->since, start, end};
+  if (from->since == 0 || start >= end) {
+    rest->dirty.since = 0;
+  }
+}
+
+/**************************************************************************************************
+ * mm_purge_freed
+ */
+void mm_purge_freed(MemoryManagement* mm, Block* block) {
+  if (block->dirty.since != 0 && mm->options.purge == PURGE_EAGER &&
+      block->size >= mm->options.purge_threshold) {
+    purge_block(mm, block);
+  }
+}
+
+/**************************************************************************************************
+ * mm_purge
+ *
+ *  Recorre la lista por dirección: los libres grandes suelen ser pocos, y así cada página se
+ *  devuelve una sola vez por pasada. Solo se devuelven los libres sucios hace al menos 'age'
+ *  comandos; los limpios ya no tienen páginas residentes que devolver.
+ */
+static int purge_pass(MemoryManagement* mm, size_t age, size_t* released) {
+  *released = 0;
+  if (mm->options.tags) {
+    fprintf(stderr, "mm_purge: PURGE no está disponible con --tags.\n");
+    return EXIT_FAILURE;
+  }
+
+  for (Block* block = mm->start_block; block != NULL; block = block->next) {
+    if (block->free && block->dirty.since != 0 && mm->purge_clock - block->dirty.since >= age &&
+        block->size >= mm->options.purge_threshold) {
+      *released += purge_block(mm, block);
+    }
+  }
+  return EXIT_SUCCESS;
+}
+
+/**************************************************************************************************
+ * mm_purge
+ */
+int mm_purge(MemoryManagement* mm, size_t* released) {
+  return purge_pass(mm, 0, released);
+}
+
+/**************************************************************************************************
+ * mm_purge_tick
+ */
+void mm_purge_tick(MemoryManagement* mm) {
+  mm->purge_clock++;
+  if (mm->options.purge != PURGE_DECAY || mm->purge_clock % mm->options.purge_period != 0) {
+    return;
+  }
+
+  size_t released;
+  purge_pass(mm, mm->options.purge_period, &released);
+}
+
+/**************************************************************************************************
+ * mm_purge_print
+ */
+int mm_purge_print(MemoryManagement* mm) {
+  size_t before = purge_rss();
+  size_t released;
+  if (mm_purge(mm, &released) != EXIT_SUCCESS) {
+    return EXIT_FAILURE;
+  }
+  size_t after = purge_rss();
+
+  printf("Purge: %zu bytes released, RSS %zu KB -> %zu KB\n", released, before / 1024,
+         after / 1024);
+  return EXIT_SUCCESS;
+}
+
+/**************************************************************************************************
+ * purge_rss
+ *
+ *  statm trae tamaños en páginas: el total mapeado y, segundo, lo residente.
+ */
+size_t purge_rss(void) {
+  FILE* file = fopen("/proc/self/statm", "r");
+  if (file == NULL) {
+    return 0;
+  }
+
+  unsigned long total, resident;
+  int           read = fscanf(file, "%lu %lu", &total, &resident);
+  fclose(file);
+  if (read != 2) {
+    return 0;
+  }
+  return (size_t) resident * (size_t) sysconf(_SC_PAGESIZE);
+}
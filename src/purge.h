@@ -0,0 +1,78 @@
+// purge.h
+
+#ifndef PURGE_H
+#define PURGE_H
+
+#include <stddef.h>
+
+#include "memory_management.h"
+
+#define PURGE_DEFAULT_MIN (64 * 1024)  // bloque libre mínimo para devolver sus páginas
+
+/**
+ * Devolución de páginas al SO (PURGE y --purge) sobre la lista de Block:
+ *  - De un bloque libre de al menos options.purge_threshold bytes se devuelven las páginas
+ *    enteras que contiene con madvise(MADV_DONTNEED); el resto de la página de los bordes es de
+ *    sus vecinos. Las páginas vuelven en cero y recién ocupan memoria cuando un ALLOC las toca.
+ *  - Con --hugepages la unidad es REGION_HUGE_PAGE, para no partir páginas grandes.
+ *  - Cada libre lleva en Block::dirty (BlockDirty) el tramo que cubre sus bytes tocados sin
+ *    devolver y el purge_clock del FREE (o COMPACT) más antiguo que los dejó; since == 0 = limpio.
+ *    Solo se devuelven las páginas enteras que tocan ese tramo, así una página ya devuelta que
+ *    absorbe un vecino sucio no se vuelve a contar. Un remanente partido hereda la parte del
+ *    tramo que le cae; una unión de libres se queda con la unión y la marca más antigua.
+ *  - Política (ver options.h): eager devuelve el bloque que deja cada FREE (y cada COMPACT);
+ *    decay hace una pasada cada options.purge_period comandos que devuelve solo los libres sucios
+ *    hace al menos purge_period comandos, así un bloque que se reusa enseguida no paga el
+ *    madvise ni las fallas de página de volver, y uno limpio no se vuelve a devolver.
+ *  - No está disponible con --tags: los chunks libres guardan sus enlaces en el payload.
+ */
+
+/**
+ * mm_purge_touch:
+ *  - Suma [start, end) al tramo sucio de 'block'; si estaba limpio queda sucio desde ahora.
+ */
+void mm_purge_touch(MemoryManagement* mm, Block* block, size_t start, size_t end);
+
+/**
+ * mm_purge_absorb / mm_purge_inherit:
+ *  - mm_purge_absorb: 'into' se queda con lo sucio de 'from', al que está absorbiendo.
+ *  - mm_purge_inherit: 'rest' (con offset y size ya puestos), partido de un libre con 'from',
+ *    hereda lo sucio que cae dentro de él.
+ */
+void mm_purge_absorb(Block* into, const Block* from);
+void mm_purge_inherit(Block* rest, const BlockDirty* from);
+
+/**
+ * mm_purge_freed:
+ *  - 'block' es libre, ya con su tamaño final y su tramo sucio. Con --purge=eager devuelve sus
+ *    páginas si está sucio y alcanza el umbral.
+ */
+void mm_purge_freed(MemoryManagement* mm, Block* block);
+
+/**
+ * mm_purge:
+ *  - Pasada completa: devuelve las páginas de cada bloque libre sucio que alcanza el umbral.
+ *  - *released: bytes pasados a madvise; solo cuentan las páginas que tocan tramos sucios.
+ */
+int mm_purge(MemoryManagement* mm, size_t* released);
+
+/**
+ * mm_purge_tick:
+ *  - Avanza purge_clock; se llama una vez por comando. Con --purge=decay, cada
+ *    options.purge_period comandos devuelve los libres sucios hace al menos ese período.
+ */
+void mm_purge_tick(MemoryManagement* mm);
+
+/**
+ * mm_purge_print:
+ *  - Comando PURGE: mm_purge e imprime los bytes devueltos y el RSS del proceso antes y después.
+ */
+int mm_purge_print(MemoryManagement* mm);
+
+/**
+ * purge_rss:
+ *  - Memoria residente del proceso en bytes (de /proc/self/statm), 0 si no se puede leer.
+ */
+size_t purge_rss(void);
+
+#endif  // PURGE_H
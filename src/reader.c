@@ -0,0 +1,149 @@
+#include "reader.h"
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define READER_BUFFER_INITIAL_CAPACITY 65536
+
+/**************************************************************************************************
+ * reader_slurp
+ *
+ *  Plan B para lo que no se puede mapear (pipes, /dev/stdin, ...): lee todo 'fd' a un buffer que
+ *  crece al doble.
+ */
+static int reader_slurp(Reader* reader, int fd) {
+  size_t capacity = READER_BUFFER_INITIAL_CAPACITY;
+  size_t length   = 0;
+  char*  buffer   = malloc(capacity);
+  if (buffer == NULL) {
+    fprintf(stderr, "reader_slurp: No se pudo reservar el buffer de lectura.\n");
+    return EXIT_FAILURE;
+  }
+
+  for (;;) {
+    if (length == capacity) {
+      char* bigger = realloc(buffer, capacity * 2);
+      if (bigger == NULL) {
+        fprintf(stderr, "reader_slurp: No se pudo ampliar el buffer de lectura.\n");
+        free(buffer);
+        return EXIT_FAILURE;
+      }
+      buffer = bigger;
+      capacity *= 2;
+    }
+
+    ssize_t count = read(fd, buffer + length, capacity - length);
+    if (count < 0) {
+      perror("reader_slurp: read");
+      free(buffer);
+      return EXIT_FAILURE;
+    }
+    if (count == 0) {
+      break;
+    }
+    length += (size_t) count;
+  }
+
+  reader->data   = buffer;
+  reader->length = length;
+  reader->mapped = false;
+  return EXIT_SUCCESS;
+}
+
+/**************************************************************************************************
+ * reader_open
+ *
+ *  Un archivo regular se mapea de solo lectura y se avisa al kernel que se recorre en orden
+ *  (MADV_SEQUENTIAL: lectura anticipada agresiva, las páginas leídas se pueden descartar
+ *  enseguida). Un archivo vacío no se mapea (mmap de 0 bytes falla): queda data = NULL.
+ */
+int reader_open(Reader* reader, const char* filename) {
+  reader->data     = NULL;
+  reader->length   = 0;
+  reader->position = 0;
+  reader->mapped   = false;
+
+  int fd = open(filename, O_RDONLY);
+  if (fd < 0) {
+    fprintf(stderr, "reader_open: No se pudo abrir el archivo: %s\n", filename);
+    return EXIT_FAILURE;
+  }
+
+  struct stat info;
+  if (fstat(fd, &info) != 0) {
+    fprintf(stderr, "reader_open: No se pudo consultar el archivo: %s\n", filename);
+    close(fd);
+    return EXIT_FAILURE;
+  }
+
+  if (S_ISREG(info.st_mode)) {
+    if (info.st_size == 0) {
+      close(fd);
+      return EXIT_SUCCESS;
+    }
+
+    void* data = mmap(NULL, (size_t) info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data != MAP_FAILED) {
+      madvise(data, (size_t) info.st_size, MADV_SEQUENTIAL);
+      reader->data   = data;
+      reader->length = (size_t) info.st_size;
+      reader->mapped = true;
+      close(fd);
+      return EXIT_SUCCESS;
+    }
+  }
+
+  int result = reader_slurp(reader, fd);
+  if (result != EXIT_SUCCESS) {
+    fprintf(stderr, "reader_open: No se pudo leer el archivo: %s\n", filename);
+  }
+  close(fd);
+  return result;
+}
+
+/**************************************************************************************************
+ * reader_close
+ */
+void reader_close(Reader* reader) {
+  if (reader->mapped) {
+    munmap((void*) reader->data, reader->length);
+  } else {
+    free((void*) reader->data);
+  }
+  reader->data     = NULL;
+  reader->length   = 0;
+  reader->position = 0;
+  reader->mapped   = false;
+}
+
+/**************************************************************************************************
+ * reader_next_line
+ *
+ *  El fin de cada línea se busca con memchr (vectorizado en la libc); la última línea puede no
+ *  tener '\n'.
+ */
+bool reader_next_line(Reader* reader, const char** line, size_t* length) {
+  while (reader->position < reader->length) {
+    const char* start     = reader->data + reader->position;
+    size_t      remaining = reader->length - reader->position;
+    const char* newline   = memchr(start, '\n', remaining);
+    size_t      size      = newline ? (size_t) (newline - start) : remaining;
+
+    reader->position += newline ? size + 1 : size;
+
+    // Ignorar líneas vacías o comentarios
+    if (size == 0 || start[0] == '#') {
+      continue;
+    }
+
+    *line   = start;
+    *length = size;
+    return true;
+  }
+  return false;
+}
@@ -0,0 +1,40 @@
+// reader.h
+
+#ifndef READER_H
+#define READER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * Lector de archivos de comandos sin copias:
+ *  - data / length: el archivo entero, mapeado con mmap (o leído a un buffer si no se puede
+ *    mapear, por ejemplo un pipe). No está terminado en '\0'.
+ *  - position: próximo byte a examinar
+ *  - mapped: data viene de mmap (se libera con munmap) y no de malloc
+ *
+ * Las líneas que entrega (y los NameView que parse_command arma sobre ellas) apuntan dentro de
+ * data: valen hasta reader_close. No hay límite de largo de línea.
+ */
+typedef struct {
+  const char* data;
+  size_t      length;
+  size_t      position;
+  bool        mapped;
+} Reader;
+
+/**
+ * reader_open / reader_close:
+ *  - reader_open mapea 'filename' entero. Devuelve EXIT_FAILURE si no puede abrirlo ni leerlo.
+ */
+int reader_open(Reader* reader, const char* filename);
+void reader_close(Reader* reader);
+
+/**
+ * reader_next_line:
+ *  - Deja en line / length la próxima línea (sin el '\n'), salteando las vacías y los
+ *    comentarios ('#' en la primera columna). Devuelve false al llegar al final del archivo.
+ */
+bool reader_next_line(Reader* reader, const char** line, size_t* length);
+
+#endif  // READER_H
@@ -0,0 +1,120 @@
+#include "region.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#define REGION_PROT  (PROT_READ | PROT_WRITE)
+#define REGION_FLAGS (MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE)
+
+/**************************************************************************************************
+ * region_length
+ *
+ *  Largo real del mapeo: con páginas grandes, 'size' redondeado a REGION_HUGE_PAGE (0 si no se
+ *  puede representar).
+ */
+static size_t region_length(size_t size, bool hugepages) {
+  if (!hugepages) {
+    return size;
+  }
+  if (size > SIZE_MAX - REGION_HUGE_PAGE) {
+    return 0;
+  }
+  return (size + REGION_HUGE_PAGE - 1) & ~(size_t) (REGION_HUGE_PAGE - 1);
+}
+
+/**************************************************************************************************
+ * region_map_aligned
+ *
+ *  Mapea REGION_HUGE_PAGE bytes de más y recorta el principio y el final para que la región
+ *  empiece en un múltiplo de REGION_HUGE_PAGE: THP solo usa páginas grandes en tramos alineados.
+ */
+static void* region_map_aligned(size_t length) {
+  if (length > SIZE_MAX - REGION_HUGE_PAGE) {
+    return NULL;
+  }
+  size_t padded = length + REGION_HUGE_PAGE;
+  char*  raw    = mmap(NULL, padded, REGION_PROT, REGION_FLAGS, -1, 0);
+  if (raw == MAP_FAILED) {
+    return NULL;
+  }
+
+  uintptr_t mask    = (uintptr_t) REGION_HUGE_PAGE - 1;
+  char*     aligned = (char*) (((uintptr_t) raw + mask) & ~mask);
+  if (aligned > raw) {
+    munmap(raw, (size_t) (aligned - raw));
+  }
+  size_t tail = (size_t) (raw + padded - (aligned + length));
+  if (tail > 0) {
+    munmap(aligned + length, tail);
+  }
+  return aligned;
+}
+
+/**************************************************************************************************
+ * region_map
+ *
+ *  MAP_HUGETLB va sin MAP_NORESERVE: así el kernel reserva las páginas del pool al mapear y, si
+ *  no hay suficientes, mmap falla acá (y se pasa a THP) en lugar de dar SIGBUS al tocarlas.
+ *  madvise es solo un consejo: con THP apagado la región queda con páginas normales.
+ */
+void* region_map(size_t size, bool hugepages) {
+  size_t length = region_length(size, hugepages);
+  if (length == 0) {
+    return NULL;
+  }
+
+  if (!hugepages) {
+    void* region = mmap(NULL, length, REGION_PROT, REGION_FLAGS, -1, 0);
+    return region != MAP_FAILED ? region : NULL;
+  }
+
+#ifdef MAP_HUGETLB
+  void* region =
+    mmap(NULL, length, REGION_PROT, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+  if (region != MAP_FAILED) {
+    return region;
+  }
+#endif
+
+  void* aligned = region_map_aligned(length);
+#ifdef MADV_HUGEPAGE
+  if (aligned != NULL) {
+    madvise(aligned, length, MADV_HUGEPAGE);
+  }
+#endif
+  return aligned;
+}
+
+/**************************************************************************************************
+ * region_page_round
+ */
+size_t region_page_round(size_t size) {
+  long   value = sysconf(_SC_PAGESIZE);
+  size_t page  = value > 0 ? (size_t) value : 4096;
+  if (size > SIZE_MAX - page) {
+    return 0;
+  }
+  return (size + page - 1) & ~(page - 1);
+}
+
+/**************************************************************************************************
+ * region_protect
+ */
+int region_protect(void* at, size_t length, bool accessible) {
+  if (length == 0) {
+    return EXIT_SUCCESS;
+  }
+  return mprotect(at, length, accessible ? REGION_PROT : PROT_NONE) == 0 ? EXIT_SUCCESS
+                                                                         : EXIT_FAILURE;
+}
+
+/**************************************************************************************************
+ * region_unmap
+ */
+void region_unmap(void* region, size_t size, bool hugepages) {
+  if (region != NULL) {
+    munmap(region, region_length(size, hugepages));
+  }
+}
@@ -0,0 +1,48 @@
+// region.h
+
+#ifndef REGION_H
+#define REGION_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#define REGION_HUGE_PAGE (2u * 1024 * 1024)  // página grande de x86-64 (y alineación para THP)
+
+/**
+ * Región de datos del simulador (memory_region), pedida al SO con mmap anónimo y privado. Las
+ * páginas se asignan recién cuando se tocan (MAP_NORESERVE: tampoco se reserva swap), así que un
+ * heap simulado de decenas de GB no ocupa memoria física hasta que los ALLOC lo rellenan.
+ */
+
+/**
+ * region_map:
+ *  - Mapea 'size' bytes en cero. Con 'hugepages' el largo se redondea a REGION_HUGE_PAGE y se
+ *    prueba primero MAP_HUGETLB (páginas del pool de /proc/sys/vm/nr_hugepages); si el pool no
+ *    alcanza, se mapea alineado a REGION_HUGE_PAGE y se pide THP con madvise(MADV_HUGEPAGE).
+ *    Con páginas de 2 MB los memset de ALLOC y REALLOC recorren la región con menos fallas de
+ *    TLB.
+ *  - Devuelve NULL si no se pudo mapear.
+ */
+void* region_map(size_t size, bool hugepages);
+
+/**
+ * region_page_round:
+ *  - 'size' redondeado a un múltiplo del tamaño de página (0 si no se puede representar).
+ */
+size_t region_page_round(size_t size);
+
+/**
+ * region_protect:
+ *  - Deja [at, at + length) accesible (lectura y escritura) o sin ningún acceso (PROT_NONE), como
+ *    la reserva de --grow (ver segment.h). 'at' y 'length' deben ser múltiplos de página.
+ *  - Devuelve EXIT_FAILURE si mprotect falla.
+ */
+int region_protect(void* at, size_t length, bool accessible);
+
+/**
+ * region_unmap:
+ *  - Libera una región de region_map; 'size' y 'hugepages' deben ser los del mapeo.
+ */
+void region_unmap(void* region, size_t size, bool hugepages);
+
+#endif  // REGION_H
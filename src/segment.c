@@ -0,0 +1,125 @@
+#include "segment.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "buddy.h"
+#include "region.h"
+
+/**************************************************************************************************
+ * segment_map
+ *
+ *  Hace accesibles los bytes [from, to) de la reserva: mprotect trabaja con páginas enteras, así
+ *  que se habilitan las páginas que empiezan a partir de la primera página aún protegida.
+ */
+static int segment_map(MemoryManagement* mm, size_t from, size_t to) {
+  if (!mm->segment_guard) {
+    return EXIT_SUCCESS;
+  }
+  size_t first = region_page_round(from);
+  size_t last  = region_page_round(to);
+  return region_protect((char*) mm->memory_region + first, last - first, true);
+}
+
+/**************************************************************************************************
+ * mm_grow
+ *
+ *  El bloque nuevo se engancha al final de la lista recorriéndola: crecer pasa a lo sumo
+ *  MM_MAX_SEGMENTS veces, y cada vez el heap se duplica.
+ */
+int mm_grow(MemoryManagement* mm, size_t size) {
+  if (!mm->options.grow || mm->options.tags) {
+    return EXIT_FAILURE;
+  }
+
+  size_t room    = mm->region_capacity - mm->total_size;
+  size_t segment = mm->total_size > 0 ? mm->total_size : size;
+  while (segment < size && segment <= room) {
+    segment *= 2;
+  }
+  if (segment > room) {
+    segment = room;
+  }
+  if (segment < size || segment == 0 || mm->segment_count == MM_MAX_SEGMENTS) {
+    fprintf(stderr, "mm_grow: El heap no puede crecer (%zu bytes de %zu, %zu segmentos).\n",
+            mm->total_size, mm->region_capacity, mm->segment_count);
+    return EXIT_FAILURE;
+  }
+
+  if (segment_map(mm, mm->total_size, mm->total_size + segment) != EXIT_SUCCESS) {
+    fprintf(stderr, "mm_grow: No se pudo mapear un segmento de %zu bytes.\n", segment);
+    return EXIT_FAILURE;
+  }
+  Block* block = block_pool_acquire(&mm->pool);
+  if (block == NULL) {
+    fprintf(stderr, "mm_grow: No se pudo reservar memoria para nuevo bloque.\n");
+    return EXIT_FAILURE;
+  }
+
+  Block* last = mm->start_block;
+  while (last != NULL && last->next != NULL) {
+    last = last->next;
+  }
+
+  block->free      = true;
+  block_name_clear(&block->name);
+  block->size      = segment;
+  block->requested = 0;
+  block->offset    = mm->total_size;
+  block->dirty.since = 0;  // segmento recién habilitado, nunca tocado
+  block->prev      = last;
+  block->next      = NULL;
+  if (last != NULL) {
+    last->next = block;
+  } else {
+    mm->start_block = block;
+    mm->rover       = block;
+  }
+
+  mm->segment_starts[mm->segment_count++] = mm->total_size;
+  mm->total_size += segment;
+  mm->stats.live_bytes += segment;  // mm_index_insert lo pasa a libre
+  mm->stats.grows++;
+  mm_index_insert(mm, block);
+
+  if (mm->strategy == STRATEGY_BUDDY) {
+    return mm_buddy_carve(mm, block);
+  }
+  return EXIT_SUCCESS;
+}
+
+/**************************************************************************************************
+ * mm_segment_start
+ *
+ *  segment_starts está ordenado (cada segmento empieza donde terminaba el heap): búsqueda
+ *  binaria sobre a lo sumo MM_MAX_SEGMENTS valores.
+ */
+bool mm_segment_start(const MemoryManagement* mm, size_t offset) {
+  if (mm->segment_count <= 1) {
+    return false;
+  }
+
+  size_t low  = 1;
+  size_t high = mm->segment_count;
+  while (low < high) {
+    size_t middle = low + (high - low) / 2;
+    if (mm->segment_starts[middle] < offset) {
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
+  }
+  return low < mm->segment_count && mm->segment_starts[low] == offset;
+}
+
+/**************************************************************************************************
+ * mm_segment_end
+ */
+size_t mm_segment_end(const MemoryManagement* mm, size_t offset) {
+  for (size_t i = 1; i < mm->segment_count; i++) {
+    if (mm->segment_starts[i] > offset) {
+      return mm->segment_starts[i];
+    }
+  }
+  return mm->total_size;
+}
@@ -0,0 +1,50 @@
+// segment.h
+
+#ifndef SEGMENT_H
+#define SEGMENT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "memory_management.h"
+
+#define SEGMENT_DEFAULT_LIMIT ((size_t) 1 << 30)  // tope de --grow sin MAX: 1 GB
+
+/**
+ * Heap que crece (--grow[=MAX]) sobre la lista de Block:
+ *  - mm_init reserva MAX bytes de espacio de direcciones (MAP_NORESERVE) y deja accesibles solo
+ *    los primeros total_size; el resto queda con PROT_NONE hasta que un segmento lo usa.
+ *  - Cuando un ALLOC no encuentra bloque, mm_grow habilita un segmento nuevo justo detrás de
+ *    total_size y lo agrega al final de la lista como un bloque libre. Cada segmento mide lo
+ *    mismo que todo el heap anterior (crecimiento geométrico: el heap se duplica), o más si el
+ *    pedido no entra, hasta el tope.
+ *  - Como la reserva es contigua, los offsets siguen siendo posiciones dentro de memory_region y
+ *    ningún bloque se mueve al crecer.
+ *  - Dos bloques de segmentos distintos nunca se fusionan (FREE, REALLOC, buddy) ni se compactan
+ *    juntos: cada segmento es un mapeo aparte para quien lo recorre.
+ *  - No está disponible con --tags ni con --arenas.
+ */
+
+/**
+ * mm_grow:
+ *  - Agrega un segmento donde entre un bloque de 'size' bytes. Con BUDDY el segmento se parte
+ *    en potencias de dos alineadas, igual que la región inicial.
+ *  - Devuelve EXIT_FAILURE sin --grow, o si el segmento no entra en el tope (o ya hay
+ *    MM_MAX_SEGMENTS).
+ */
+int mm_grow(MemoryManagement* mm, size_t size);
+
+/**
+ * mm_segment_start:
+ *  - Indica si 'offset' es el comienzo de un segmento agregado por mm_grow: un bloque que
+ *    empieza ahí no se une con el anterior. Sin segmentos extra es siempre false, en O(1).
+ */
+bool mm_segment_start(const MemoryManagement* mm, size_t offset);
+
+/**
+ * mm_segment_end:
+ *  - Fin (exclusivo) del segmento que contiene 'offset'.
+ */
+size_t mm_segment_end(const MemoryManagement* mm, size_t offset);
+
+#endif  // SEGMENT_H
@@ -0,0 +1,55 @@
+// stats.h
+
+#ifndef STATS_H
+#define STATS_H
+
+#include <stddef.h>
+
+/**
+ * Estadísticas de un MemoryManagement, siempre activas: cada campo se actualiza en O(1) en el
+ * mismo lugar donde cambia lo que cuenta, así que leerlas nunca recorre la lista de bloques.
+ *  - live_bytes: bytes de bloques ocupados (chunks completos con --tags)
+ *  - free_bytes / free_blocks: bytes y bloques en los índices de libres (la lista de libres con
+ *    --tags); se mantienen en mm_index_insert / mm_index_remove
+ *  - cached_bytes: bytes de los bloques guardados en la caché de --cache (ver block_cache.h)
+ *  - lost_bytes: remanentes de split o de REALLOC que no llegaron a MM_SPLIT_THRESHOLD y
+ *    desaparecieron de la lista (live + free + cached + lost = total_size)
+ *  - splits: bloques libres nuevos creados al partir uno (ALLOC, REALLOC que achica o crece)
+ *  - merges: fusiones de dos bloques contiguos (FREE, y REALLOC que crece sobre su vecino)
+ *  - leaks / leaked_bytes: “fugas” de REALLOC y bytes del bloque viejo que quedaron ocupados
+ *  - moves / moved_bytes: REALLOC que mudaron el bloque (--realloc=move) y bytes copiados
+ *  - purges / purged_bytes: llamadas a madvise(MADV_DONTNEED) de PURGE y --purge y bytes que
+ *    abarcaron (una página ya devuelta puede contarse más de una vez)
+ *  - compactions / compacted_bytes: pasadas de mm_compact y bytes que movieron en total
+ *  - grows: segmentos agregados con --grow (ver segment.h)
+ *  - coalesce_sweeps: pasadas de mm_coalesce con --coalesce=lazy
+ *  - cache_hits / cache_misses: ALLOC de tamaño cacheable que salieron de la caché o tuvieron
+ *    que buscar bloque; cache_flushes: vaciados de una pila llena o de toda la caché
+ *
+ * El mayor bloque libre sale de los índices (ver mm_largest_free) y la fragmentación externa es
+ * 1 - mayor libre / free_bytes.
+ */
+typedef struct {
+  size_t live_bytes;
+  size_t free_bytes;
+  size_t free_blocks;
+  size_t cached_bytes;
+  size_t lost_bytes;
+  size_t splits;
+  size_t merges;
+  size_t leaks;
+  size_t leaked_bytes;
+  size_t moves;
+  size_t moved_bytes;
+  size_t compactions;
+  size_t compacted_bytes;
+  size_t purges;
+  size_t purged_bytes;
+  size_t grows;
+  size_t cache_hits;
+  size_t cache_misses;
+  size_t cache_flushes;
+  size_t coalesce_sweeps;
+} MMStats;
+
+#endif  // STATS_H
@@ -7,6 +7,11 @@ typedef enum {
   STRATEGY_BEST,
   STRATEGY_FIRST,
   STRATEGY_WORST,
+  STRATEGY_NEXT,
+  STRATEGY_BUDDY,
+  STRATEGY_TLSF,
 } StrategyType;
 
+#define STRATEGY_COUNT (STRATEGY_TLSF + 1)  // para recorrer todas las estrategias
+
 #endif  // STRATEGY_H
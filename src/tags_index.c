@@ -0,0 +1,167 @@
+#include "tags_index.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "name_table.h"
+
+/**************************************************************************************************
+ * tags_index_lookup
+ *
+ *  Sondea desde la posición del hash hasta la primera entrada vacía y devuelve la entrada USED
+ *  del chunk (name, offset), o NULL si no está.
+ */
+static TagsIndexEntry* tags_index_lookup(const TagsIndex* index, const BlockName* name,
+                                         uint64_t hash, size_t offset) {
+  size_t mask = index->capacity - 1;
+  for (size_t i = (size_t) hash & mask; index->entries[i].state != NAME_INDEX_EMPTY;
+       i = (i + 1) & mask) {
+    TagsIndexEntry* entry = &index->entries[i];
+    if (entry->state == NAME_INDEX_USED && entry->offset == offset && entry->hash == hash &&
+        block_name_equal(&entry->name, name)) {
+      return entry;
+    }
+  }
+  return NULL;
+}
+
+/**************************************************************************************************
+ * tags_index_rehash
+ *
+ *  Reconstruye la tabla con 'capacity' entradas, descartando los tombstones.
+ */
+static int tags_index_rehash(TagsIndex* index, size_t capacity) {
+  TagsIndexEntry* entries = calloc(capacity, sizeof(TagsIndexEntry));
+  if (entries == NULL) {
+    fprintf(stderr, "tags_index_rehash: No se pudo reservar la tabla de %zu entradas.\n",
+            capacity);
+    return EXIT_FAILURE;
+  }
+
+  size_t mask = capacity - 1;
+  for (size_t j = 0; j < index->capacity; j++) {
+    TagsIndexEntry* old = &index->entries[j];
+    if (old->state != NAME_INDEX_USED) {
+      continue;
+    }
+    size_t i = (size_t) old->hash & mask;
+    while (entries[i].state != NAME_INDEX_EMPTY) {
+      i = (i + 1) & mask;
+    }
+    entries[i] = *old;
+  }
+
+  free(index->entries);
+  index->entries    = entries;
+  index->capacity   = capacity;
+  index->tombstones = 0;
+  return EXIT_SUCCESS;
+}
+
+/**************************************************************************************************
+ * tags_index_init
+ */
+int tags_index_init(TagsIndex* index) {
+  index->entries    = calloc(TAGS_INDEX_INITIAL_CAPACITY, sizeof(TagsIndexEntry));
+  index->capacity   = TAGS_INDEX_INITIAL_CAPACITY;
+  index->count      = 0;
+  index->tombstones = 0;
+  if (index->entries == NULL) {
+    fprintf(stderr, "tags_index_init: No se pudo reservar el índice de nombres.\n");
+    index->capacity = 0;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+
+/**************************************************************************************************
+ * tags_index_destroy
+ */
+void tags_index_destroy(TagsIndex* index) {
+  free(index->entries);
+  index->entries    = NULL;
+  index->capacity   = 0;
+  index->count      = 0;
+  index->tombstones = 0;
+}
+
+/**************************************************************************************************
+ * tags_index_insert
+ *
+ *  Misma política de crecimiento que name_index_insert. La entrada nueva va en el primer lugar
+ *  reutilizable de su sonda: las búsquedas siguen hasta una vacía, así que encuentran también a
+ *  los demás chunks con el mismo nombre.
+ */
+int tags_index_insert(TagsIndex* index, const BlockName* name, size_t offset) {
+  if ((index->count + index->tombstones + 1) * 4 > index->capacity * 3) {
+    size_t capacity = index->capacity;
+    if ((index->count + 1) * 2 > capacity) {
+      capacity *= 2;
+    }
+    if (tags_index_rehash(index, capacity) != EXIT_SUCCESS) {
+      return EXIT_FAILURE;
+    }
+  }
+
+  uint64_t hash = block_name_hash(name);
+  size_t   mask = index->capacity - 1;
+  size_t   i    = (size_t) hash & mask;
+  while (index->entries[i].state == NAME_INDEX_USED) {
+    i = (i + 1) & mask;
+  }
+
+  TagsIndexEntry* slot = &index->entries[i];
+  if (slot->state == NAME_INDEX_DELETED) {
+    index->tombstones--;
+  }
+  slot->state  = NAME_INDEX_USED;
+  slot->hash   = hash;
+  slot->name   = *name;
+  slot->offset = offset;
+  index->count++;
+  return EXIT_SUCCESS;
+}
+
+/**************************************************************************************************
+ * tags_index_remove
+ */
+void tags_index_remove(TagsIndex* index, const BlockName* name, size_t offset) {
+  TagsIndexEntry* entry = tags_index_lookup(index, name, block_name_hash(name), offset);
+  if (entry == NULL) {
+    return;
+  }
+  entry->state = NAME_INDEX_DELETED;
+  index->count--;
+  index->tombstones++;
+}
+
+/**************************************************************************************************
+ * tags_index_move
+ */
+void tags_index_move(TagsIndex* index, const BlockName* name, size_t from, size_t to) {
+  TagsIndexEntry* entry = tags_index_lookup(index, name, block_name_hash(name), from);
+  if (entry != NULL) {
+    entry->offset = to;
+  }
+}
+
+/**************************************************************************************************
+ * tags_index_find
+ *
+ *  Entre los chunks con el mismo nombre gana el de menor offset, como en el recorrido lineal.
+ */
+bool tags_index_find(const TagsIndex* index, const BlockName* name, size_t* offset) {
+  uint64_t hash  = block_name_hash(name);
+  size_t   mask  = index->capacity - 1;
+  bool     found = false;
+  for (size_t i = (size_t) hash & mask; index->entries[i].state != NAME_INDEX_EMPTY;
+       i = (i + 1) & mask) {
+    const TagsIndexEntry* entry = &index->entries[i];
+    if (entry->state == NAME_INDEX_USED && entry->hash == hash &&
+        block_name_equal(&entry->name, name) && (!found || entry->offset < *offset)) {
+      *offset = entry->offset;
+      found   = true;
+    }
+  }
+  return found;
+}
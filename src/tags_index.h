@@ -0,0 +1,72 @@
+// tags_index.h
+
+#ifndef TAGS_INDEX_H
+#define TAGS_INDEX_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "block.h"
+#include "name_index.h"
+
+#define TAGS_INDEX_INITIAL_CAPACITY 64  // potencia de dos
+
+/**
+ * Una entrada de la tabla: un chunk ocupado de --tags.
+ *  - hash: block_name_hash de name
+ *  - name / offset: nombre del chunk y su offset dentro de memory_region
+ */
+typedef struct {
+  NameIndexState state;
+  uint64_t       hash;
+  BlockName      name;
+  size_t         offset;
+} TagsIndexEntry;
+
+/**
+ * Índice de nombres de --tags: como NameIndex, pero sin nodos Block a los que encadenar, así que
+ * guarda una entrada por chunk ocupado (nombre -> offset). Los chunks con el mismo nombre
+ * (ALLOC duplicado o la “fuga” de REALLOC) quedan en la misma sonda, que se recorre entera.
+ *  - capacity: cantidad de entradas (potencia de dos)
+ *  - count: entradas en uso
+ *  - tombstones: entradas borradas que todavía ocupan lugar en las sondas
+ */
+typedef struct {
+  TagsIndexEntry* entries;
+  size_t          capacity;
+  size_t          count;
+  size_t          tombstones;
+} TagsIndex;
+
+/**
+ * tags_index_init / tags_index_destroy:
+ *  - tags_index_init reserva TAGS_INDEX_INITIAL_CAPACITY entradas vacías; devuelve EXIT_FAILURE
+ *    (con entries en NULL) si no hay memoria.
+ */
+int tags_index_init(TagsIndex* index);
+void tags_index_destroy(TagsIndex* index);
+
+/**
+ * tags_index_insert / tags_index_remove:
+ *  - Agregan o quitan el chunk ocupado 'offset' con nombre 'name' (no vacío).
+ *  - tags_index_insert devuelve EXIT_FAILURE si la tabla necesitaba crecer y no hubo memoria.
+ */
+int tags_index_insert(TagsIndex* index, const BlockName* name, size_t offset);
+void tags_index_remove(TagsIndex* index, const BlockName* name, size_t offset);
+
+/**
+ * tags_index_move:
+ *  - El chunk 'name' de 'from' pasó a empezar en 'to' (REALLOC que se une con el vecino
+ *    izquierdo), sin reservar nada.
+ */
+void tags_index_move(TagsIndex* index, const BlockName* name, size_t from, size_t to);
+
+/**
+ * tags_index_find:
+ *  - Deja en *offset el chunk ocupado con ese nombre y menor offset (el mismo que encontraría el
+ *    recorrido por dirección) y devuelve true, o false si no hay ninguno.
+ */
+bool tags_index_find(const TagsIndex* index, const BlockName* name, size_t* offset);
+
+#endif  // TAGS_INDEX_H
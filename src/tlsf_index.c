@@ -0,0 +1,144 @@
+#include "tlsf_index.h"
+
+/**************************************************************************************************
+ * tlsf_index_mapping
+ *
+ *  fl = floor(log2(size)); sl = los TLSF_SL_BITS bits que siguen al más significativo. Para
+ *  tamaños menores a 2^TLSF_SL_BITS se corre a la izquierda, así cada tamaño tiene su subclase.
+ */
+static void tlsf_index_mapping(size_t size, size_t* fl, size_t* sl) {
+  if (size == 0) {
+    *fl = 0;
+    *sl = 0;
+    return;
+  }
+
+  *fl = (size_t) (63 - __builtin_clzll((unsigned long long) size));
+  if (*fl >= TLSF_SL_BITS) {
+    *sl = (size >> (*fl - TLSF_SL_BITS)) & (TLSF_SL_COUNT - 1);
+  } else {
+    *sl = (size << (TLSF_SL_BITS - *fl)) & (TLSF_SL_COUNT - 1);
+  }
+}
+
+/**************************************************************************************************
+ * tlsf_index_init
+ */
+void tlsf_index_init(TlsfIndex* index) {
+  for (size_t fl = 0; fl < TLSF_FL_COUNT; fl++) {
+    for (size_t sl = 0; sl < TLSF_SL_COUNT; sl++) {
+      index->heads[fl][sl] = NULL;
+    }
+    index->sl_bitmap[fl] = 0;
+  }
+  index->fl_bitmap = 0;
+}
+
+/**************************************************************************************************
+ * tlsf_index_insert
+ *
+ *  Inserta el bloque al inicio de su lista y enciende los bits de ambos niveles.
+ */
+void tlsf_index_insert(TlsfIndex* index, Block* block) {
+  size_t fl, sl;
+  tlsf_index_mapping(block->size, &fl, &sl);
+
+  Block* head      = index->heads[fl][sl];
+  block->prev_free = NULL;
+  block->next_free = head;
+  if (head != NULL) {
+    head->prev_free = block;
+  }
+
+  index->heads[fl][sl] = block;
+  index->sl_bitmap[fl] |= (uint16_t) (1u << sl);
+  index->fl_bitmap     |= UINT64_C(1) << fl;
+}
+
+/**************************************************************************************************
+ * tlsf_index_remove
+ *
+ *  Desenlaza el bloque; si su lista queda vacía apaga el bit de segundo nivel y, si ese era el
+ *  último de su clase, también el de primer nivel.
+ */
+void tlsf_index_remove(TlsfIndex* index, Block* block) {
+  size_t fl, sl;
+  tlsf_index_mapping(block->size, &fl, &sl);
+
+  if (block->prev_free != NULL) {
+    block->prev_free->next_free = block->next_free;
+  } else {
+    index->heads[fl][sl] = block->next_free;
+  }
+  if (block->next_free != NULL) {
+    block->next_free->prev_free = block->prev_free;
+  }
+
+  block->next_free = NULL;
+  block->prev_free = NULL;
+
+  if (index->heads[fl][sl] == NULL) {
+    index->sl_bitmap[fl] &= (uint16_t) ~(1u << sl);
+    if (index->sl_bitmap[fl] == 0) {
+      index->fl_bitmap &= ~(UINT64_C(1) << fl);
+    }
+  }
+}
+
+/**************************************************************************************************
+ * tlsf_index_find
+ *
+ *  Redondear hacia arriba evita recorrer la lista de la subclase de requested_size, que puede
+ *  tener bloques más chicos: a cambio se puede saltear un bloque que justo alcanzaba (la
+ *  fragmentación acotada que acepta TLSF).
+ */
+Block* tlsf_index_find(const TlsfIndex* index, size_t requested_size, size_t* steps) {
+  size_t fl, sl;
+  tlsf_index_mapping(requested_size, &fl, &sl);
+
+  if (fl >= TLSF_SL_BITS) {
+    size_t round = ((size_t) 1 << (fl - TLSF_SL_BITS)) - 1;
+    if (requested_size > SIZE_MAX - round) {
+      return NULL;
+    }
+    tlsf_index_mapping(requested_size + round, &fl, &sl);
+  }
+
+  // 1) Alguna subclase >= sl en la misma clase:
+  ++*steps;
+  uint32_t sl_map = index->sl_bitmap[fl] & (~0u << sl);
+  if (sl_map == 0) {
+    // 2) Si no, la subclase más chica de la primera clase no vacía mayor que fl:
+    if (fl + 1 >= TLSF_FL_COUNT) {
+      return NULL;
+    }
+    ++*steps;
+    uint64_t fl_map = index->fl_bitmap & (~UINT64_C(0) << (fl + 1));
+    if (fl_map == 0) {
+      return NULL;
+    }
+    fl     = (size_t) __builtin_ctzll(fl_map);
+    sl_map = index->sl_bitmap[fl];
+  }
+
+  return index->heads[fl][__builtin_ctz(sl_map)];
+}
+
+/**************************************************************************************************
+ * tlsf_index_max
+ */
+Block* tlsf_index_max(const TlsfIndex* index) {
+  if (index->fl_bitmap == 0) {
+    return NULL;
+  }
+
+  size_t fl      = 63 - (size_t) __builtin_clzll(index->fl_bitmap);
+  size_t sl      = 31 - (size_t) __builtin_clz(index->sl_bitmap[fl]);
+  Block* largest = index->heads[fl][sl];
+  for (Block* block = largest->next_free; block != NULL; block = block->next_free) {
+    if (block->size > largest->size) {
+      largest = block;
+    }
+  }
+  return largest;
+}
@@ -0,0 +1,60 @@
+// tlsf_index.h
+
+#ifndef TLSF_INDEX_H
+#define TLSF_INDEX_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "block.h"
+
+#define TLSF_FL_COUNT 64                     // primer nivel: una clase por potencia de dos
+#define TLSF_SL_BITS  4                      // segundo nivel: 2^4 subdivisiones lineales
+#define TLSF_SL_COUNT (1 << TLSF_SL_BITS)
+
+/**
+ * Índice TLSF (two-level segregated fit) de bloques libres:
+ *  - heads[fl][sl]: lista (vía next_free / prev_free) de los bloques libres cuyo tamaño cae en
+ *                   [2^fl + sl * 2^(fl - SL_BITS), 2^fl + (sl + 1) * 2^(fl - SL_BITS)).
+ *  - fl_bitmap: bit fl encendido ⇔ sl_bitmap[fl] != 0
+ *  - sl_bitmap[fl]: bit sl encendido ⇔ heads[fl][sl] != NULL
+ *
+ * Insertar, quitar y buscar son O(1): solo usan clz/ctz sobre los bitmaps, nunca recorren listas.
+ */
+typedef struct {
+  Block*   heads[TLSF_FL_COUNT][TLSF_SL_COUNT];
+  uint64_t fl_bitmap;
+  uint16_t sl_bitmap[TLSF_FL_COUNT];
+} TlsfIndex;
+
+/**
+ * tlsf_index_init:
+ *  - Deja todas las listas vacías.
+ */
+void tlsf_index_init(TlsfIndex* index);
+
+/**
+ * tlsf_index_insert / tlsf_index_remove:
+ *  - Agregan o quitan un bloque libre de la lista de su par (fl, sl). El tamaño del bloque no
+ *    debe cambiar mientras esté en el índice.
+ */
+void tlsf_index_insert(TlsfIndex* index, Block* block);
+void tlsf_index_remove(TlsfIndex* index, Block* block);
+
+/**
+ * tlsf_index_find:
+ *  - Redondea requested_size hacia arriba al inicio de la siguiente subclase y devuelve la cabeza
+ *    de la primera lista no vacía desde ahí: cualquier bloque de esa lista tiene
+ *    size >= requested_size. Devuelve NULL si no hay ninguna.
+ *  - Suma a *steps los bitmaps consultados (uno o dos: la búsqueda no recorre bloques).
+ */
+Block* tlsf_index_find(const TlsfIndex* index, size_t requested_size, size_t* steps);
+
+/**
+ * tlsf_index_max:
+ *  - Bloque libre más grande: el mayor de la lista de la subclase no vacía más alta (solo esa
+ *    lista se recorre). NULL si el índice está vacío.
+ */
+Block* tlsf_index_max(const TlsfIndex* index);
+
+#endif  // TLSF_INDEX_H
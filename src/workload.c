@@ -0,0 +1,478 @@
+#include "workload.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "parser.h"
+
+#define WORKLOAD_HEAP_INITIAL_CAPACITY 1024
+#define WORKLOAD_NAME_LENGTH           24     // "o" + hasta 20 dígitos + '\0'
+#define WORKLOAD_WRITE_BUFFER          65536
+#define WORKLOAD_MAX_FIELDS            3
+
+/**
+ * Un bloque vivo de la carga: muere en el comando 'death'; se llama "o<id>".
+ */
+typedef struct {
+  uint64_t death;
+  uint64_t id;
+  size_t   size;
+} WorkloadObject;
+
+/**
+ * Min-heap de vivos por death.
+ */
+typedef struct {
+  WorkloadObject* items;
+  size_t          count;
+  size_t          capacity;
+} WorkloadHeap;
+
+/**
+ * Estado del generador mientras emite.
+ */
+typedef struct {
+  const WorkloadConfig* config;
+  WorkloadSink          sink;
+  void*                 context;
+  uint64_t              random;
+  uint64_t              now;         // comandos emitidos hasta ahora
+  uint64_t              next_id;
+  size_t                live_bytes;
+  WorkloadHeap          heap;
+} Workload;
+
+/**
+ * Destino de workload_write_text: arma las líneas en un buffer propio y escribe de a bloques.
+ */
+typedef struct {
+  FILE*  file;
+  size_t length;
+  char   buffer[WORKLOAD_WRITE_BUFFER];
+} WorkloadWriter;
+
+/**************************************************************************************************
+ * workload_defaults
+ */
+void workload_defaults(WorkloadConfig* config) {
+  config->ops                   = 1000000;
+  config->seed                  = 1;
+  config->heap_size             = 1024 * 1024;
+  config->occupancy             = 0.5;
+  config->size_kind             = WORKLOAD_SIZE_POWER_LAW;
+  config->alpha                 = 1.5;
+  config->min_size              = 16;
+  config->max_size              = 16384;
+  config->small_size            = 32;
+  config->large_size            = 4096;
+  config->large_fraction        = 0.1;
+  config->lifetime_kind         = WORKLOAD_LIFETIME_EXPONENTIAL;
+  config->mean_lifetime         = 1000.0;
+  config->phase_length          = 10000;
+  config->long_lived_fraction   = 0.05;
+  config->realloc_rate          = 0.05;
+  config->realloc_growth        = 1.5;
+  config->realloc_grow_fraction = 0.5;
+  config->drain                 = false;
+  config->print                 = false;
+}
+
+/**************************************************************************************************
+ * workload_parse_fields
+ *
+ *  Lee hasta 'count' números separados por ':' de 'text'. Devuelve cuántos leyó, o 0 si algún
+ *  campo no es un número.
+ */
+static size_t workload_parse_fields(const char* text, double* values, size_t count) {
+  size_t read = 0;
+  while (read < count) {
+    char* end;
+    values[read] = strtod(text, &end);
+    if (end == text || (*end != ':' && *end != '\0')) {
+      return 0;
+    }
+    read++;
+    if (*end == '\0') {
+      return read;
+    }
+    text = end + 1;
+  }
+  return 0;  // sobran campos
+}
+
+/**************************************************************************************************
+ * workload_parse_option
+ */
+int workload_parse_option(WorkloadConfig* config, const char* arg) {
+  double values[WORKLOAD_MAX_FIELDS];
+  size_t fields;
+
+  if (strncmp(arg, "--ops=", 6) == 0) {
+    config->ops = strtoull(arg + 6, NULL, 10);
+    return EXIT_SUCCESS;
+  }
+  if (strncmp(arg, "--seed=", 7) == 0) {
+    config->seed = strtoull(arg + 7, NULL, 10);
+    return EXIT_SUCCESS;
+  }
+  if (strncmp(arg, "--heap=", 7) == 0) {
+    config->heap_size = strtoull(arg + 7, NULL, 10);
+    if (config->heap_size > 0) {
+      return EXIT_SUCCESS;
+    }
+  } else if (strncmp(arg, "--occupancy=", 12) == 0) {
+    fields = workload_parse_fields(arg + 12, values, 1);
+    if (fields == 1 && values[0] > 0 && values[0] <= 1) {
+      config->occupancy = values[0];
+      return EXIT_SUCCESS;
+    }
+  } else if (strncmp(arg, "--sizes=power:", 14) == 0) {
+    fields = workload_parse_fields(arg + 14, values, 3);
+    if (fields == 3 && values[0] > 0 && values[1] >= 1 && values[2] >= values[1]) {
+      config->size_kind = WORKLOAD_SIZE_POWER_LAW;
+      config->alpha     = values[0];
+      config->min_size  = (size_t) values[1];
+      config->max_size  = (size_t) values[2];
+      return EXIT_SUCCESS;
+    }
+  } else if (strncmp(arg, "--sizes=bimodal:", 16) == 0) {
+    fields = workload_parse_fields(arg + 16, values, 3);
+    if (fields == 3 && values[0] >= 1 && values[1] >= 1 && values[2] >= 0 && values[2] <= 1) {
+      config->size_kind      = WORKLOAD_SIZE_BIMODAL;
+      config->small_size     = (size_t) values[0];
+      config->large_size     = (size_t) values[1];
+      config->large_fraction = values[2];
+      return EXIT_SUCCESS;
+    }
+  } else if (strncmp(arg, "--lifetime=exp:", 15) == 0) {
+    fields = workload_parse_fields(arg + 15, values, 1);
+    if (fields == 1 && values[0] > 0) {
+      config->lifetime_kind = WORKLOAD_LIFETIME_EXPONENTIAL;
+      config->mean_lifetime = values[0];
+      return EXIT_SUCCESS;
+    }
+  } else if (strncmp(arg, "--lifetime=phase:", 17) == 0) {
+    fields = workload_parse_fields(arg + 17, values, 2);
+    if (fields == 2 && values[0] >= 1 && values[1] >= 0 && values[1] <= 1) {
+      config->lifetime_kind       = WORKLOAD_LIFETIME_PHASED;
+      config->phase_length        = (size_t) values[0];
+      config->long_lived_fraction = values[1];
+      return EXIT_SUCCESS;
+    }
+  } else if (strncmp(arg, "--realloc=", 10) == 0) {
+    fields = workload_parse_fields(arg + 10, values, 3);
+    if (fields == 3 && values[0] >= 0 && values[0] <= 1 && values[1] >= 1 && values[2] >= 0 &&
+        values[2] <= 1) {
+      config->realloc_rate          = values[0];
+      config->realloc_growth        = values[1];
+      config->realloc_grow_fraction = values[2];
+      return EXIT_SUCCESS;
+    }
+  } else if (strcmp(arg, "--drain") == 0) {
+    config->drain = true;
+    return EXIT_SUCCESS;
+  } else if (strcmp(arg, "--print") == 0) {
+    config->print = true;
+    return EXIT_SUCCESS;
+  }
+
+  fprintf(stderr, "workload_parse_option: Opción inválida: %s\n", arg);
+  return EXIT_FAILURE;
+}
+
+/**************************************************************************************************
+ * workload_random / workload_uniform
+ *
+ *  splitmix64: rápido, de buena calidad y reproducible en cualquier plataforma. workload_uniform
+ *  devuelve un double en (0, 1], que se puede pasar a log sin cuidado.
+ */
+static uint64_t workload_random(Workload* workload) {
+  uint64_t z = (workload->random += UINT64_C(0x9E3779B97F4A7C15));
+  z = (z ^ (z >> 30)) * UINT64_C(0xBF58476D1CE4E5B9);
+  z = (z ^ (z >> 27)) * UINT64_C(0x94D049BB133111EB);
+  return z ^ (z >> 31);
+}
+
+static double workload_uniform(Workload* workload) {
+  return (double) ((workload_random(workload) >> 11) + 1) * 0x1.0p-53;
+}
+
+/**************************************************************************************************
+ * workload_size
+ *
+ *  Power-law por inversa de la CDF de Pareto, recortada a max_size. Bimodal: uniforme en
+ *  [m/2, 3m/2) alrededor de la moda elegida.
+ */
+static size_t workload_size(Workload* workload) {
+  const WorkloadConfig* config = workload->config;
+
+  if (config->size_kind == WORKLOAD_SIZE_POWER_LAW) {
+    double size = (double) config->min_size * pow(workload_uniform(workload), -1.0 / config->alpha);
+    return size >= (double) config->max_size ? config->max_size : (size_t) size;
+  }
+
+  size_t mode = workload_uniform(workload) <= config->large_fraction ? config->large_size
+                                                                     : config->small_size;
+  size_t size = mode / 2 + (size_t) (workload_uniform(workload) * (double) mode);
+  return size == 0 ? 1 : size;
+}
+
+/**************************************************************************************************
+ * workload_death
+ *
+ *  Instante (en comandos) en que muere un bloque asignado ahora.
+ */
+static uint64_t workload_death(Workload* workload) {
+  const WorkloadConfig* config = workload->config;
+
+  if (config->lifetime_kind == WORKLOAD_LIFETIME_PHASED &&
+      workload_uniform(workload) > config->long_lived_fraction) {
+    return (workload->now / config->phase_length + 1) * config->phase_length;
+  }
+  return workload->now + 1 + (uint64_t) (-config->mean_lifetime * log(workload_uniform(workload)));
+}
+
+/**************************************************************************************************
+ * workload_heap_push / workload_heap_pop
+ */
+static int workload_heap_push(WorkloadHeap* heap, WorkloadObject object) {
+  if (heap->count == heap->capacity) {
+    size_t          capacity = heap->capacity == 0 ? WORKLOAD_HEAP_INITIAL_CAPACITY
+                                                   : heap->capacity * 2;
+    WorkloadObject* items    = realloc(heap->items, capacity * sizeof(WorkloadObject));
+    if (items == NULL) {
+      fprintf(stderr, "workload_heap_push: No se pudo ampliar el heap de vivos.\n");
+      return EXIT_FAILURE;
+    }
+    heap->items    = items;
+    heap->capacity = capacity;
+  }
+
+  size_t i = heap->count++;
+  while (i > 0 && heap->items[(i - 1) / 2].death > object.death) {
+    heap->items[i] = heap->items[(i - 1) / 2];
+    i              = (i - 1) / 2;
+  }
+  heap->items[i] = object;
+  return EXIT_SUCCESS;
+}
+
+static WorkloadObject workload_heap_pop(WorkloadHeap* heap) {
+  WorkloadObject top  = heap->items[0];
+  WorkloadObject last = heap->items[--heap->count];
+
+  size_t i = 0;
+  for (;;) {
+    size_t child = 2 * i + 1;
+    if (child >= heap->count) {
+      break;
+    }
+    if (child + 1 < heap->count && heap->items[child + 1].death < heap->items[child].death) {
+      child++;
+    }
+    if (last.death <= heap->items[child].death) {
+      break;
+    }
+    heap->items[i] = heap->items[child];
+    i              = child;
+  }
+  if (heap->count > 0) {
+    heap->items[i] = last;
+  }
+  return top;
+}
+
+/**************************************************************************************************
+ * workload_emit
+ *
+ *  Arma el nombre "o<id>" en un buffer local y entrega el comando al sink.
+ */
+static int workload_emit(Workload* workload, CommandType type, uint64_t id, size_t size) {
+  char    name[WORKLOAD_NAME_LENGTH];
+  Command command;
+  command.type      = type;
+  command.size      = size;
+  command.thread_id = 0;
+  command.name.data = NULL;
+  command.name.length = 0;
+
+  if (command_has_name(type)) {
+    command.name.data   = name;
+    command.name.length = (size_t) snprintf(name, sizeof(name), "o%llu", (unsigned long long) id);
+  }
+
+  workload->now++;
+  return workload->sink(workload->context, &command);
+}
+
+/**************************************************************************************************
+ * workload_free_first
+ *
+ *  Libera el vivo que muere primero.
+ */
+static int workload_free_first(Workload* workload) {
+  WorkloadObject object = workload_heap_pop(&workload->heap);
+  workload->live_bytes -= object.size;
+  return workload_emit(workload, CMD_FREE, object.id, 0);
+}
+
+/**************************************************************************************************
+ * workload_step
+ *
+ *  Un comando (o varios FREE seguidos y un ALLOC si hubo que hacer lugar), sin pasar de 'limit'
+ *  comandos emitidos.
+ */
+static int workload_step(Workload* workload, uint64_t limit) {
+  const WorkloadConfig* config = workload->config;
+  WorkloadHeap*         heap   = &workload->heap;
+
+  // 1) Algún vivo ya venció:
+  if (heap->count > 0 && heap->items[0].death <= workload->now) {
+    return workload_free_first(workload);
+  }
+
+  // 2) REALLOC de un vivo cualquiera (la posición en el heap no depende del tamaño):
+  if (heap->count > 0 && workload_uniform(workload) <= config->realloc_rate) {
+    WorkloadObject* object = &heap->items[workload_random(workload) % heap->count];
+    size_t          size   = object->size;
+    if (workload_uniform(workload) <= config->realloc_grow_fraction) {
+      size = (size_t) ceil((double) size * config->realloc_growth);
+    } else {
+      size = (size_t) ((double) size / config->realloc_growth);
+      size = size == 0 ? 1 : size;
+    }
+    workload->live_bytes += size;
+    workload->live_bytes -= object->size;
+    object->size = size;
+    return workload_emit(workload, CMD_REALLOC, object->id, size);
+  }
+
+  // 3) ALLOC, liberando antes lo que muere primero si no entra en la ocupación pedida:
+  size_t size   = workload_size(workload);
+  size_t target = (size_t) (config->occupancy * (double) config->heap_size);
+  while (heap->count > 0 && workload->live_bytes + size > target) {
+    if (workload->now + 1 >= limit) {
+      return workload_free_first(workload);  // no queda lugar para el ALLOC
+    }
+    if (workload_free_first(workload) != EXIT_SUCCESS) {
+      return EXIT_FAILURE;
+    }
+  }
+
+  WorkloadObject object = {workload_death(workload), workload->next_id++, size};
+  if (workload_heap_push(heap, object) != EXIT_SUCCESS) {
+    return EXIT_FAILURE;
+  }
+  workload->live_bytes += size;
+  return workload_emit(workload, CMD_ALLOC, object.id, size);
+}
+
+/**************************************************************************************************
+ * workload_generate
+ */
+int workload_generate(const WorkloadConfig* config, WorkloadSink sink, void* context) {
+  Workload workload;
+  memset(&workload, 0, sizeof(Workload));
+  workload.config  = config;
+  workload.sink    = sink;
+  workload.context = context;
+  workload.random  = config->seed;
+
+  int result = EXIT_SUCCESS;
+  while (result == EXIT_SUCCESS && workload.now < config->ops) {
+    result = workload_step(&workload, config->ops);
+  }
+  while (result == EXIT_SUCCESS && config->drain && workload.heap.count > 0) {
+    result = workload_free_first(&workload);
+  }
+  if (result == EXIT_SUCCESS && config->print) {
+    result = workload_emit(&workload, CMD_PRINT, 0, 0);
+  }
+
+  free(workload.heap.items);
+  return result;
+}
+
+/**************************************************************************************************
+ * workload_writer_flush
+ */
+static int workload_writer_flush(WorkloadWriter* writer) {
+  if (writer->length > 0 && fwrite(writer->buffer, 1, writer->length, writer->file) !=
+                                writer->length) {
+    fprintf(stderr, "workload_writer_flush: No se pudo escribir la traza.\n");
+    return EXIT_FAILURE;
+  }
+  writer->length = 0;
+  return EXIT_SUCCESS;
+}
+
+/**************************************************************************************************
+ * workload_writer_number
+ *
+ *  Escribe 'value' en decimal; más rápido que printf para millones de líneas.
+ */
+static void workload_writer_number(WorkloadWriter* writer, size_t value) {
+  char   digits[24];
+  size_t count = 0;
+  do {
+    digits[count++] = (char) ('0' + value % 10);
+    value /= 10;
+  } while (value != 0);
+  while (count > 0) {
+    writer->buffer[writer->length++] = digits[--count];
+  }
+}
+
+/**************************************************************************************************
+ * workload_writer_sink
+ */
+static int workload_writer_sink(void* context, const Command* command) {
+  static const char* const WORDS[] = {"ALLOC", "REALLOC", "FREE", "PRINT", "STATS",
+                                      "COMPACT", "PURGE"};
+  WorkloadWriter*          writer  = context;
+
+  // El comando más largo: palabra, nombre, tamaño de 20 dígitos, separadores y '\n':
+  if (writer->length + 8 + command->name.length + 24 > WORKLOAD_WRITE_BUFFER &&
+      workload_writer_flush(writer) != EXIT_SUCCESS) {
+    return EXIT_FAILURE;
+  }
+
+  const char* word = WORDS[command->type];
+  size_t      size = strlen(word);
+  memcpy(writer->buffer + writer->length, word, size);
+  writer->length += size;
+
+  if (command_has_name(command->type)) {
+    writer->buffer[writer->length++] = ' ';
+    memcpy(writer->buffer + writer->length, command->name.data, command->name.length);
+    writer->length += command->name.length;
+  }
+  if (command->type == CMD_ALLOC || command->type == CMD_REALLOC ||
+      (command->type == CMD_COMPACT && command->size != 0)) {
+    writer->buffer[writer->length++] = ' ';
+    workload_writer_number(writer, command->size);
+  }
+  writer->buffer[writer->length++] = '\n';
+  return EXIT_SUCCESS;
+}
+
+/**************************************************************************************************
+ * workload_write_text
+ */
+int workload_write_text(const WorkloadConfig* config, FILE* file) {
+  WorkloadWriter* writer = malloc(sizeof(WorkloadWriter));
+  if (writer == NULL) {
+    fprintf(stderr, "workload_write_text: No se pudo reservar el buffer de escritura.\n");
+    return EXIT_FAILURE;
+  }
+  writer->file   = file;
+  writer->length = 0;
+
+  int result = workload_generate(config, workload_writer_sink, writer);
+  if (result == EXIT_SUCCESS) {
+    result = workload_writer_flush(writer);
+  }
+  free(writer);
+  return result;
+}
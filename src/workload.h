@@ -0,0 +1,108 @@
+// workload.h
+
+#ifndef WORKLOAD_H
+#define WORKLOAD_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "command.h"
+
+/**
+ * Distribución de tamaños de ALLOC:
+ *  - POWER_LAW: Pareto con exponente alpha en [min_size, max_size] (muchos chicos, cola pesada)
+ *  - BIMODAL: alrededor de small_size o, con probabilidad large_fraction, de large_size (±50%)
+ */
+typedef enum {
+  WORKLOAD_SIZE_POWER_LAW,
+  WORKLOAD_SIZE_BIMODAL
+} WorkloadSizeKind;
+
+/**
+ * Distribución de vidas (en comandos emitidos):
+ *  - EXPONENTIAL: vida exponencial de media mean_lifetime
+ *  - PHASED: lo asignado en una fase de phase_length comandos muere al terminar la fase, salvo
+ *    una fracción long_lived_fraction que vive una vida exponencial de media mean_lifetime
+ */
+typedef enum {
+  WORKLOAD_LIFETIME_EXPONENTIAL,
+  WORKLOAD_LIFETIME_PHASED
+} WorkloadLifetimeKind;
+
+/**
+ * Parámetros de una carga sintética (ver workload_defaults y workload_parse_option):
+ *  - ops / seed: comandos a emitir y semilla (misma semilla y parámetros, misma traza)
+ *  - heap_size / occupancy: la carga mantiene los bytes vivos por debajo de
+ *    occupancy * heap_size, liberando antes de tiempo los que iban a morir primero. No acota
+ *    la fragmentación ni los remanentes perdidos del simulador: una traza larga puede no entrar
+ *    en heap_size sin --compact-retry
+ *  - realloc_rate: probabilidad de que un comando sea REALLOC de un bloque vivo al azar; crece
+ *    por realloc_growth con probabilidad realloc_grow_fraction y si no achica por el mismo factor
+ *  - drain: al final libera todo lo que quedó vivo (además de los ops); print: termina con PRINT
+ */
+typedef struct {
+  size_t               ops;
+  uint64_t             seed;
+  size_t               heap_size;
+  double               occupancy;
+  WorkloadSizeKind     size_kind;
+  double               alpha;
+  size_t               min_size;
+  size_t               max_size;
+  size_t               small_size;
+  size_t               large_size;
+  double               large_fraction;
+  WorkloadLifetimeKind lifetime_kind;
+  double               mean_lifetime;
+  size_t               phase_length;
+  double               long_lived_fraction;
+  double               realloc_rate;
+  double               realloc_growth;
+  double               realloc_grow_fraction;
+  bool                 drain;
+  bool                 print;
+} WorkloadConfig;
+
+/**
+ * Destino de cada comando generado. El NameView de command vale solo durante la llamada.
+ * Devolver EXIT_FAILURE corta la generación.
+ */
+typedef int (*WorkloadSink)(void* context, const Command* command);
+
+/**
+ * workload_defaults:
+ *  - 1M comandos para la región de 1 MB del simulador, tamaños power-law (alpha 1.5, 16 a 16384),
+ *    vidas exponenciales de media 1000, 50% de ocupación y 5% de REALLOC que crecen x1.5 la
+ *    mitad de las veces.
+ */
+void workload_defaults(WorkloadConfig* config);
+
+/**
+ * workload_parse_option:
+ *  - Aplica una opción de la línea de comandos a 'config':
+ *      --ops=N  --seed=N  --heap=BYTES  --occupancy=F
+ *      --sizes=power:ALPHA:MIN:MAX  |  --sizes=bimodal:SMALL:LARGE:FRACCION
+ *      --lifetime=exp:MEDIA  |  --lifetime=phase:LARGO:FRACCION_LONGEVA
+ *      --realloc=TASA:FACTOR:FRACCION_CRECE  --drain  --print
+ *  - Devuelve EXIT_FAILURE si no la reconoce o un valor no tiene sentido.
+ */
+int workload_parse_option(WorkloadConfig* config, const char* arg);
+
+/**
+ * workload_generate:
+ *  - Emite la carga comando por comando a 'sink'. El reloj es la cantidad de comandos emitidos:
+ *    en cada paso se libera el bloque vivo cuya vida venció (si hay), o se emite un REALLOC, o
+ *    un ALLOC (liberando antes, si no entra en la ocupación, los que morían primero).
+ *  - Los vivos están en un heap por instante de muerte: cada paso es O(log vivos).
+ */
+int workload_generate(const WorkloadConfig* config, WorkloadSink sink, void* context);
+
+/**
+ * workload_write_text:
+ *  - Genera la carga y la escribe en el formato de texto de los archivos de comandos.
+ */
+int workload_write_text(const WorkloadConfig* config, FILE* file);
+
+#endif  // WORKLOAD_H
@@ -0,0 +1,19 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "binary_trace.h"
+
+/**************************************************************************************************
+ * trace2bin
+ *
+ *  Convierte un archivo de comandos de texto a una traza binaria (ver binary_trace.h), que
+ *  memory_management reconoce por su magic y repite sin tokenizar.
+ */
+int main(int argc, char** argv) {
+  if (argc != 3) {
+    fprintf(stderr, "Usage: %s <input.txt> <output.bin>\n", argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  return binary_trace_convert(argv[1], argv[2]);
+}
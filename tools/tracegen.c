@@ -0,0 +1,42 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "workload.h"
+
+/**************************************************************************************************
+ * tracegen
+ *
+ *  Genera una carga sintética (ver workload.h) en el formato de texto de los archivos de
+ *  comandos, en 'output' o en stdout.
+ */
+int main(int argc, char** argv) {
+  WorkloadConfig config;
+  workload_defaults(&config);
+
+  const char* output = NULL;
+  for (int i = 1; i < argc; i++) {
+    if (argv[i][0] != '-' && output == NULL) {
+      output = argv[i];
+    } else if (workload_parse_option(&config, argv[i]) != EXIT_SUCCESS) {
+      fprintf(stderr,
+              "Usage: %s [--ops=N] [--seed=N] [--heap=BYTES] [--occupancy=F] "
+              "[--sizes=power:ALPHA:MIN:MAX|bimodal:SMALL:LARGE:FRACTION] "
+              "[--lifetime=exp:MEAN|phase:LENGTH:LONG_FRACTION] "
+              "[--realloc=RATE:GROWTH:GROW_FRACTION] [--drain] [--print] [output].\n",
+              argv[0]);
+      return EXIT_FAILURE;
+    }
+  }
+
+  FILE* file = output != NULL ? fopen(output, "w") : stdout;
+  if (file == NULL) {
+    fprintf(stderr, "tracegen: No se pudo crear el archivo: %s\n", output);
+    return EXIT_FAILURE;
+  }
+
+  int result = workload_write_text(&config, file);
+  if (file != stdout && fclose(file) != 0) {
+    result = EXIT_FAILURE;
+  }
+  return result;
+}